@@ -10,7 +10,40 @@ glyph_count = int(f.readline())
 img = Image.open(png_name)
 
 glyph_data = []
+glyph_span_data = []
 glyphs = []
+native_glyph_span_data = []
+native_glyphs = []
+
+
+def encode_native_spans(bitmap, width, height, phase):
+  '''Filters a glyph to half size for NativeFX, as drawn |phase| (0 or 1) rows
+  below an even row, and encodes it like kGlyphSpanData.
+
+  Each pixel covers a 2x2 block of the bitmap. Blocks with one or two set
+  pixels become half covered and those with three or four fully covered. The
+  runs of half covered pixels have the top bit of their length set.
+  '''
+  rows = [[0] * width] * phase + bitmap
+  rows += [[0] * width] * (len(rows) % 2)
+  data = []
+  for y in range(0, len(rows), 2):
+    levels = []
+    for x in range(0, width, 2):
+      covered = sum(rows[y][x:x + 2]) + sum(rows[y + 1][x:x + 2])
+      levels.append(0 if not covered else 1 if covered <= 2 else 2)
+    spans = []
+    for x, level in enumerate(levels):
+      if not level:
+        continue
+      if spans and spans[-1][0] + spans[-1][1] == x and spans[-1][2] == level:
+        spans[-1][1] += 1
+      else:
+        spans.append([x, 1, level])
+    data.append(len(spans))
+    for start, length, level in spans:
+      data += [start, length | (0x80 if level == 1 else 0)]
+  return data
 first_glyph = None
 last_glyph = None
 
@@ -25,15 +58,25 @@ for i in range(glyph_count):
     first_glyph = char
   last_glyph = char
 
-  glyphs.append((w, h, len(glyph_data)))
+  offset = len(glyph_data)
+  span_offset = len(glyph_span_data)
 
+  bitmap = []
   for gy in range(h):
+    bitmap.append([])
     bits = '0b'
     bit_count = 0
+    # Horizontal runs of set pixels on this row as (start, length) pairs.
+    spans = []
     for gx in range(w):
       p = img.getpixel((x + gx, y + gy))
+      bitmap[-1].append(int(p[3] >= 128))
       if p[3] >= 128:
         bits += '1'
+        if spans and spans[-1][0] + spans[-1][1] == gx:
+          spans[-1][1] += 1
+        else:
+          spans.append([gx, 1])
       else:
         bits += '0'
       bit_count += 1
@@ -45,6 +88,20 @@ for i in range(glyph_count):
       if bit_count < 32:
         bits += '0' * (32 - bit_count)
       glyph_data.append(bits)
+    glyph_span_data.append(len(spans))
+    for start, length in spans:
+      glyph_span_data += [start, length]
+
+  glyphs.append((w, h, offset, span_offset,
+                 len(glyph_span_data) - span_offset))
+  # Every glyph's spans start on a word boundary.
+  glyph_span_data += [0] * (-len(glyph_span_data) % 4)
+
+  native_glyphs.append([])
+  for phase in range(2):
+    spans = encode_native_spans(bitmap, w + w % 2, h, phase)
+    native_glyphs[-1].append((len(native_glyph_span_data), len(spans)))
+    native_glyph_span_data += spans + [0] * (-len(spans) % 4)
 
 print(f'''
 #pragma once
@@ -54,18 +111,52 @@ print(f'''
 struct Glyph {{
  uint8_t width;
  uint8_t height;
+ // Offset into kGlyphData in words, and into kGlyphSpanData in bytes.
  uint16_t offset;
+ uint16_t span_offset;
+ uint16_t span_size;
+}};
+
+// A glyph pre-filtered to half size for NativeFX, as drawn at an even or at an
+// odd row.
+struct NativeGlyph {{
+ // Offset into kNativeGlyphSpanData in bytes.
+ uint16_t span_offset;
+ uint16_t span_size;
 }};
 ''')
 
-print('constexpr uint32_t DRAM_ATTR kGlyphData[] = {')
+
+def print_words(name, data):
+  print(f'constexpr uint32_t {name}[] = {{')
+  for i in range(0, len(data), 24):
+    words = [data[j] | (data[j + 1] << 8) | (data[j + 2] << 16) |
+             (data[j + 3] << 24) for j in range(i, min(i + 24, len(data)), 4)]
+    print('  ' + ' '.join('0x%08x,' % w for w in words))
+  print('};')
+
+
+# The glyph data stays in flash, which can only be read a word at a time. It is
+# copied to RAM by AssetCache before drawing.
+print('constexpr uint32_t kGlyphData[] = {')
 for g1, g2 in zip(glyph_data[::2], glyph_data[1::2]):
   print(f'  {g1}, {g2},')
 print('};')
 
+# Each glyph row as a span count followed by (start, length) pairs.
+# Packed into little-endian words like kGlyphData.
+print_words('kGlyphSpanData', glyph_span_data)
+
+# The same for NativeFX, see encode_native_spans().
+print_words('kNativeGlyphSpanData', native_glyph_span_data)
+
 print(f'constexpr uint8_t kFirstGlyph = {first_glyph};')
 print(f'constexpr uint8_t kLastGlyph = {last_glyph};')
 print('constexpr Glyph DRAM_ATTR kGlyphs[] = {')
 for g in glyphs:
-  print(f'  {{{g[0]}, {g[1]}, {g[2]}}},')
+  print(f'  {{{g[0]}, {g[1]}, {g[2]}, {g[3]}, {g[4]}}},')
+print('};')
+print('constexpr NativeGlyph DRAM_ATTR kNativeGlyphs[][2] = {')
+for phases in native_glyphs:
+  print('  {' + ', '.join(f'{{{o}, {n}}}' for o, n in phases) + '},')
 print('};')
\ No newline at end of file
@@ -1,5 +1,28 @@
+import argparse
+import sys
+
 from PIL import Image
 
+# Usage:
+#   python sprites2c.py > ../main/sprites.h
+#   python sprites2c.py --compiled 4:Blend:NS_SAVED,... \
+#       > ../main/sprites_compiled.h
+#
+# A compiled routine is only emitted if it saves at least one ns per frame for
+# every --max-bytes-per-ns bytes of IRAM it takes, by default one, so a 4 KB
+# routine has to save 4 us of every frame. NS_SAVED is the interpreted minus
+# the compiled time from the host bench (see BenchmarkCompiledSprites()), times
+# the number of draws per frame. Pass --max-bytes-per-ns 0 to emit every listed
+# routine for benchmarking.
+parser = argparse.ArgumentParser()
+parser.add_argument('--compiled', metavar='INDEX[:VARIANT[:NS_SAVED]],...',
+                    help='emit unrolled draw routines for these sprites, in '
+                    'all or one of the variants, instead of the sprite data')
+parser.add_argument('--max-bytes-per-ns', type=float, default=1,
+                    help='IRAM bytes a routine may take per ns it saves per '
+                    'frame, or 0 for no limit')
+args = parser.parse_args()
+
 files = [
   'sprites/sprite1.PNG',
   'sprites/sprite2.PNG',
@@ -29,11 +52,189 @@ palette = [
   0xf4f4f4,
 ]
 
+
+def encode_spans(pixels, width, height):
+  '''Encodes a sprite as rows of runs of non-transparent pixel pairs.
+
+  Each run is a (skip, count) record followed by |count| bytes of pixel data,
+  where |skip| is the number of fully transparent bytes before the run. If
+  the top bit of |count| is set, some of the pixels in the run are transparent
+  and need to be blended individually. A record with a zero count ends the
+  row.
+  '''
+  data = []
+  for y in range(height):
+    row = pixels[y * width:(y + 1) * width]
+    pairs = [p1 | (p2 << 4) for p1, p2 in zip(row[::2], row[1::2])]
+    skip = 0
+    x = 0
+    while x < len(pairs):
+      if not pairs[x]:
+        skip += 1
+        x += 1
+        continue
+      masked = not (pairs[x] & 0x0f and pairs[x] & 0xf0)
+      run = []
+      while (x < len(pairs) and pairs[x] and len(run) < 0x7f and
+             masked == (not (pairs[x] & 0x0f and pairs[x] & 0xf0))):
+        run.append(pairs[x])
+        x += 1
+      data += [skip, len(run) | (0x80 if masked else 0)] + run
+      skip = 0
+    data += [0, 0]
+  return data
+
+
+def native_pixel(samples):
+  '''Returns the NativeFX pixel closest to the average of four sprite pixels.
+
+  A NativeFX pixel is an even mix of two palette colors, a | (b << 4). In
+  sprites, b = 0 instead mixes a with the pixel underneath, and 0 is fully
+  transparent. The candidates are compared over a black and a white
+  background, and ties go to the more opaque one.
+  '''
+  colors = sorted(set(s for s in samples if s))
+  candidates = [(a | (a << 4), {a: 1}) for a in colors]
+  candidates += [(a | (b << 4), {a: 0.5, b: 0.5})
+                 for i, a in enumerate(colors) for b in colors[i + 1:]]
+  candidates += [(a, {a: 0.5, 0: 0.5}) for a in colors]
+  candidates.append((0, {0: 1}))
+  target = {}
+  for s in samples:
+    target[s] = target.get(s, 0) + 0.25
+
+  def average(weights, background):
+    rgb = [0, 0, 0]
+    for index, weight in weights.items():
+      c = palette[index] if index else background
+      for i in range(3):
+        rgb[i] += weight * ((c >> (8 * i)) & 0xff)
+    return rgb
+
+  def error(weights):
+    return sum((x - y) ** 2 for background in (0x000000, 0xffffff)
+               for x, y in zip(average(weights, background),
+                               average(target, background)))
+
+  return min(candidates, key=lambda c: error(c[1]))[0]
+
+
+def prefilter(pixels, width, height, phase):
+  '''Filters a sprite to half its size for NativeFX, as drawn |phase| (0 or 1)
+  rows below an even row, i.e., with |phase| transparent rows above it.
+
+  Returns one byte per pixel, see native_pixel().
+  '''
+  rows = [[0] * width] * phase + [pixels[y * width:(y + 1) * width]
+                                  for y in range(height)]
+  rows += [[0] * width] * (len(rows) % 2)
+  data = []
+  for y in range(0, len(rows), 2):
+    for x in range(0, width, 2):
+      data.append(native_pixel(rows[y][x:x + 2] + rows[y + 1][x:x + 2]))
+  return data
+
+
+# Bytes per backbuffer line, i.e., RainbowFX::kWidth / 2.
+LINE_BYTES = 96
+
+# The DrawTraits variants that get a compiled routine, as (name, blend,
+# scale2x). The span variants draw the same as the blend ones.
+COMPILED_VARIANTS = [
+  ('Default', False, True),
+  ('Blend', True, True),
+  ('Blend1X', True, False),
+]
+
+
+def compile_row(row, blend, scale2x, align):
+  '''Returns the stores that draw one sprite row and their code size.
+
+  Opaque bytes are written with immediates, as 32 or 16-bit words wherever
+  |align| (the destination address modulo 4) allows. Bytes with one
+  transparent pixel are blended with the backbuffer. The code size is an
+  estimate for the Xtensa LX106: 3 bytes per instruction, plus a 4 byte
+  literal for values that don't fit movi.
+  '''
+  if scale2x:
+    # Every pixel becomes a byte, on two lines.
+    values = [p | (p << 4) for p in row]
+    masks = [0xff if p or not blend else 0 for p in row]
+    lines = [0, LINE_BYTES]
+  else:
+    values = [p1 | (p2 << 4) for p1, p2 in zip(row[::2], row[1::2])]
+    masks = [(0x0f if p1 or not blend else 0) | (0xf0 if p2 or not blend else 0)
+             for p1, p2 in zip(row[::2], row[1::2])]
+    lines = [0]
+  stores = []
+  size = 0
+  x = 0
+  while x < len(values):
+    if not masks[x]:
+      x += 1
+      continue
+    if masks[x] != 0xff:
+      stores.append(f'BlendCompiled8(d + {x}, 0x{0xff ^ masks[x]:02x}, '
+                    f'0x{values[x]:02x});')
+      size += 5 * 3
+      x += 1
+      continue
+    for width, bits in ((4, 32), (2, 16), (1, 8)):
+      if (align + x) % width or masks[x:x + width] != [0xff] * width:
+        continue
+      value = sum(v << (8 * i) for i, v in enumerate(values[x:x + width]))
+      stores.append(f'StoreCompiled{bits}(d + {x}, 0x{value:0{width * 2}x});')
+      size += 2 * 3 + (4 if value > 2047 else 0)
+      x += width
+      break
+  code = []
+  for line in lines:
+    code += [st.replace('d + ', f'd + {line} + ') if line else st
+             for st in stores]
+  return code, size * len(lines)
+
+
+def compile_sprite(pixels, width, height, index, name, blend, scale2x, align):
+  '''Returns a routine that draws a range of rows of a sprite, and its
+  estimated code size.
+
+  The routine jumps into a sequence of row blocks, each of which draws a row
+  and moves to the next one, so vertical clipping doesn't need the generic
+  path.
+  '''
+  line_step = LINE_BYTES * (2 if scale2x else 1)
+  body = []
+  size = 0
+  for y in range(height):
+    row = pixels[y * width:(y + 1) * width]
+    code, row_size = compile_row(row, blend, scale2x, align)
+    body.append(f'    case {y}:')
+    body.append(f'      if (last_row <= {y})')
+    body.append('        return;')
+    body += ['      ' + c for c in code]
+    if y < height - 1:
+      body.append(f'      d += {line_step};')
+      body.append('      // Fall through.')
+    size += row_size + 3 * 3
+  fn = f'DrawCompiledSprite{index}{name}Align{align}'
+  lines = [
+    f'inline void IRAM_ATTR {fn}(uint8_t* d, int first_row, int last_row) {{',
+    '  switch (first_row) {',
+  ] + body + [
+    '  }',
+    '}',
+    '',
+  ]
+  return fn, lines, size
+
+sprite_span_data = []
+native_sprite_data = []
+
 for fn in files:
   img = Image.open(fn)
   if img.size[0] % 2:
     img = img.crop((-1, 0, img.size[0] + 2, img.size[1]))
-  sprites.append((img.size[0], img.size[1], len(sprite_data) // 2))
+  first_pixel = len(sprite_data)
 
   for y in range(img.size[1]):
     for x in range(img.size[0]):
@@ -44,6 +245,108 @@ for fn in files:
       else:
         i = palette.index(c)
       sprite_data.append(i)
+  spans = encode_spans(sprite_data[first_pixel:], img.size[0], img.size[1])
+  native_offsets = []
+  for phase in range(2):
+    native_offsets.append(len(native_sprite_data))
+    native_sprite_data += prefilter(sprite_data[first_pixel:], img.size[0],
+                                    img.size[1], phase)
+    native_sprite_data += [0] * (-len(native_sprite_data) % 4)
+
+  sprites.append((img.size[0], img.size[1], first_pixel // 2,
+                  len(sprite_span_data), len(spans), native_offsets,
+                  len(sprites)))
+  # Every sprite starts on a word boundary, see print_words().
+  sprite_data += [0] * (-len(sprite_data) % 8)
+  sprite_span_data += spans + [0] * (-len(spans) % 4)
+
+if args.compiled is not None:
+  # Maps (index, variant name) to the ns saved per frame, if known.
+  compiled = {}
+  for item in filter(None, args.compiled.split(',')):
+    index, _, variant = item.partition(':')
+    variant, _, ns_saved = variant.partition(':')
+    for name, _, _ in COMPILED_VARIANTS:
+      if variant in ('', name):
+        compiled[(int(index), name)] = float(ns_saved) if ns_saved else None
+  print('''
+#pragma once
+
+#include <esp_attr.h>
+#include <stdint.h>
+
+// Unrolled draw routines for some of the sprites in sprites.h, generated by
+// sprites2c.py --compiled. Each one draws sprite rows [first_row, last_row)
+// to |d|, the backbuffer byte at the left of row |first_row|, whose address
+// modulo 4 is the routine's alignment.
+''')
+  print(f'constexpr int kCompiledSpriteLineBytes = {LINE_BYTES};')
+  print('''
+typedef void (*CompiledSpriteRoutine)(uint8_t* d, int first_row, int last_row);
+
+struct CompiledSprite {
+  // Indexed by alignment, or all null if the sprite isn't compiled.
+  CompiledSpriteRoutine routines[4];
+  // Estimated code size of all four routines.
+  uint32_t code_bytes;
+};
+
+enum CompiledSpriteVariant {
+  kCompiledDefault,
+  kCompiledBlend,
+  kCompiledBlend1X,
+};
+
+inline void StoreCompiled8(uint8_t* d, uint8_t value) {
+  *d = value;
+}
+
+inline void StoreCompiled16(uint8_t* d, uint16_t value) {
+  *reinterpret_cast<uint16_t*>(d) = value;
+}
+
+inline void StoreCompiled32(uint8_t* d, uint32_t value) {
+  *reinterpret_cast<uint32_t*>(d) = value;
+}
+
+// Keeps the pixel under |mask| and sets the other one to |value|.
+inline void BlendCompiled8(uint8_t* d, uint8_t mask, uint8_t value) {
+  *d = (*d & mask) | value;
+}
+''')
+  table = []
+  for width, height, offset, _, _, _, index in sprites:
+    pixels = sprite_data[offset * 2:offset * 2 + width * height]
+    entries = []
+    for name, blend, scale2x in COMPILED_VARIANTS:
+      if (index, name) not in compiled:
+        entries.append('{{nullptr, nullptr, nullptr, nullptr}, 0}')
+        continue
+      routines = [compile_sprite(pixels, width, height, index, name, blend,
+                                 scale2x, align) for align in range(4)]
+      total = sum(size for _, _, size in routines)
+      ns_saved = compiled[(index, name)]
+      if args.max_bytes_per_ns and (
+          not ns_saved or total > args.max_bytes_per_ns * ns_saved):
+        saved = f'{ns_saved:g}' if ns_saved else 'unknown'
+        print(f'Skipping sprite {index} {name}: {total} bytes for {saved} ns '
+              'saved per frame', file=sys.stderr)
+        entries.append('{{nullptr, nullptr, nullptr, nullptr}, 0}')
+        continue
+      fns = []
+      for fn, lines, _ in routines:
+        print('\n'.join(lines))
+        fns.append(fn)
+      entries.append('{{' + ',\n      '.join(fns) + f'}},\n     {total}}}')
+    table.append(entries)
+  print('constexpr CompiledSprite kCompiledSprites[][3] = {')
+  for entries in table:
+    print('  {')
+    for e in entries:
+      print(f'    {e},')
+    print('  },')
+  print('};')
+  raise SystemExit
 
 print(f'''
 #pragma once
@@ -53,21 +356,44 @@ print(f'''
 struct Sprite {{
  uint8_t width;
  uint8_t height;
+ // Byte offsets into kSpriteData and kSpriteSpanData.
  uint16_t offset;
+ uint16_t span_offset;
+ uint16_t span_size;
+ // Byte offsets into kNativeSpriteData of the sprite pre-filtered to half
+ // size, as drawn at an even and at an odd row.
+ uint16_t native_offset[2];
+ uint8_t index;
 }};
 ''')
 
-print('constexpr uint8_t DRAM_ATTR kSpriteData[] = {')
-n = 0
-for p1, p2 in zip(sprite_data[::2], sprite_data[1::2]):
-  print('  0x%02x,' % (p1 | (p2 << 4)), end='')
-  n += 1
-  if n == 8:
-    print()
-    n = 0
-print('};')
+def print_words(name, data):
+  '''Prints bytes as little-endian words.
+
+  The data stays in flash, which can only be read a word at a time. It is
+  copied to RAM by AssetCache before drawing.
+  '''
+  data = data + [0] * (-len(data) % 4)
+  print(f'constexpr uint32_t {name}[] = {{')
+  for i in range(0, len(data), 24):
+    words = [data[j] | (data[j + 1] << 8) | (data[j + 2] << 16) |
+             (data[j + 3] << 24) for j in range(i, min(i + 24, len(data)), 4)]
+    print('  ' + ' '.join('0x%08x,' % w for w in words))
+  print('};')
+
+print_words('kSpriteData',
+            [p1 | (p2 << 4) for p1, p2 in zip(sprite_data[::2],
+                                              sprite_data[1::2])])
+
+# Run-length encoded version of the sprites for blending. See encode_spans().
+print_words('kSpriteSpanData', sprite_span_data)
+
+# The sprites filtered to half size for NativeFX, one byte per pixel. See
+# prefilter().
+print_words('kNativeSpriteData', native_sprite_data)
 
 print('constexpr Sprite DRAM_ATTR kSprites[] = {')
 for s in sprites:
-  print(f'  {{{s[0]}, {s[1]}, {s[2]}}},')
+  print(f'  {{{s[0]}, {s[1]}, {s[2]}, {s[3]}, {s[4]}, '
+        f'{{{s[5][0]}, {s[5][1]}}}, {s[6]}}},')
 print('};')
@@ -0,0 +1,87 @@
+// Checks that frames scanned out with damage tracking and the panel's copy and
+// fill commands leave the same image on the emulated panel as full frames.
+
+#include <stdio.h>
+
+#include <memory>
+#include <vector>
+
+#include "display_host.h"
+#include "rainbow_fx.h"
+#include "scene.h"
+#include "test_util.h"
+#include "util.h"
+
+namespace {
+
+constexpr size_t kDisplayPixels = Display::kWidth * Display::kHeight;
+
+using Frame = std::vector<uint16_t>;
+
+// Draws |frame_count| frames of |scene| with the distance changing by
+// |step_mm| per frame and returns the panel contents after each.
+std::vector<Frame> RunFrames(Display::ColorMode color_mode,
+                             void (*scene)(RainbowFX&, uint32_t),
+                             int step_mm,
+                             bool full_frames,
+                             size_t frame_count) {
+  auto rainbow_fx = std::unique_ptr<RainbowFX>(new RainbowFX());
+  auto display = std::unique_ptr<Display>(new Display());
+  rainbow_fx->SetColorMode(display.get(), color_mode);
+  rainbow_fx->set_hardware_acceleration(!full_frames);
+  // Fills have the color of the empty rows, so make it one that 256 color mode
+  // can't show exactly.
+  auto palette = kPalette;
+  palette[0] = ExplodeRGB565(PackRGB565(0x29366f));
+  rainbow_fx->SetPalette(palette);
+  std::vector<Frame> frames;
+  uint32_t display_mm = 1234;
+  for (size_t i = 0; i < frame_count; i++) {
+    scene(*rainbow_fx, display_mm);
+    rainbow_fx->BeginRender(full_frames || i == 0);
+    display->Execute(rainbow_fx->commands(), rainbow_fx->command_count());
+    display->Render(rainbow_fx->scan_rects(), rainbow_fx->scan_rect_count(),
+                    [&](uint32_t* pixels, size_t count) {
+                      rainbow_fx->Render(pixels, count);
+                    });
+    const uint16_t* framebuffer = GetDisplayFramebuffer();
+    frames.emplace_back(framebuffer, framebuffer + kDisplayPixels);
+    display_mm = (display_mm + 2000 + step_mm) % 2000;
+  }
+  return frames;
+}
+
+void TestScenario(const char* name,
+                  Display::ColorMode color_mode,
+                  void (*scene)(RainbowFX&, uint32_t),
+                  int step_mm) {
+  constexpr size_t kFrames = 100;
+  auto expected = RunFrames(color_mode, scene, step_mm, true, kFrames);
+  auto actual = RunFrames(color_mode, scene, step_mm, false, kFrames);
+  for (size_t i = 0; i < kFrames; i++) {
+    if (expected[i] == actual[i])
+      continue;
+    size_t pixel = 0;
+    while (expected[i][pixel] == actual[i][pixel])
+      pixel++;
+    fprintf(stderr, "%s(%d): frame %zu differs first at (%zu, %zu)\n", name,
+            step_mm, i, pixel % Display::kWidth, pixel / Display::kWidth);
+    g_failures++;
+    return;
+  }
+}
+
+}  // namespace
+
+int main() {
+  const int kSteps[] = {0, 1, 7, 16, -16, 64, -64};
+  for (int step_mm : kSteps) {
+    TestScenario("Scene", Display::COLOR_MODE_65K, Render, step_mm);
+    TestScenario("Scene/256", Display::COLOR_MODE_256, Render, step_mm);
+    TestScenario("Background", Display::COLOR_MODE_65K, RenderBackground,
+                 step_mm);
+    TestScenario("Background/256", Display::COLOR_MODE_256, RenderBackground,
+                 step_mm);
+  }
+  return TestResult("Accelerated frames match full frames");
+}
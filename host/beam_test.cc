@@ -0,0 +1,188 @@
+// Checks that BeamFX renders the same frames as RainbowFX.
+
+#include "beam_fx.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "rainbow_fx.h"
+#include "scene.h"
+#include "sprites.h"
+#include "test_util.h"
+
+namespace {
+
+constexpr size_t kDisplayPixels = Display::kWidth * Display::kHeight;
+
+// Resolves a frame in batches, like the display driver.
+template <Display::ColorMode kColorMode, typename Renderer>
+void ResolveFrame(Renderer&& render, uint32_t* frame) {
+  constexpr size_t kBitsPerPixel = Display::BitsPerPixel(kColorMode);
+  constexpr size_t kBatchPixels = 64 * 8 / kBitsPerPixel;
+  for (size_t i = 0; i < kDisplayPixels / kBatchPixels; i++)
+    render(frame + i * kBatchPixels * kBitsPerPixel / 32, kBatchPixels);
+}
+
+template <Display::ColorMode kColorMode>
+void ExpectSameFrame(const char* name,
+                     int param,
+                     RainbowFX& rainbow_fx,
+                     BeamFX& beam_fx) {
+  static uint32_t expected[kDisplayPixels / 2];
+  static uint32_t actual[kDisplayPixels / 2];
+  size_t bytes = kDisplayPixels * Display::BitsPerPixel(kColorMode) / 8;
+  rainbow_fx.BeginRender(true);
+  ResolveFrame<kColorMode>(
+      [&](uint32_t* pixels, size_t count) {
+        rainbow_fx.Render<RainbowFX::kResolveKernel, kColorMode>(pixels,
+                                                                  count);
+      },
+      expected);
+  beam_fx.BeginRender();
+  ResolveFrame<kColorMode>(
+      [&](uint32_t* pixels, size_t count) {
+        beam_fx.Render<kColorMode>(pixels, count);
+      },
+      actual);
+  if (memcmp(expected, actual, bytes)) {
+    size_t i = 0;
+    auto e = reinterpret_cast<const uint8_t*>(expected);
+    auto a = reinterpret_cast<const uint8_t*>(actual);
+    while (e[i] == a[i])
+      i++;
+    size_t pixel = i * 8 / Display::BitsPerPixel(kColorMode);
+    fprintf(stderr, "%s(%d): frames differ first at (%zu, %zu)\n", name,
+            param, pixel % Display::kWidth, pixel / Display::kWidth);
+    g_failures++;
+  }
+}
+
+void TestScene(RainbowFX& rainbow_fx, BeamFX& beam_fx) {
+  for (uint32_t mm = 0; mm < 4000; mm += 13) {
+    Render(rainbow_fx, mm);
+    Render(beam_fx, mm);
+    ExpectSameFrame<Display::COLOR_MODE_65K>("Scene", mm, rainbow_fx,
+                                             beam_fx);
+    ExpectSameFrame<Display::COLOR_MODE_256>("Scene/256", mm, rainbow_fx,
+                                             beam_fx);
+  }
+}
+
+void TestBackground(RainbowFX& rainbow_fx, BeamFX& beam_fx) {
+  // Scrolls by a row, by most of the screen, back and forth, and not at all,
+  // with the layer redrawing only the rows that came into view.
+  const uint32_t kDistances[] = {0,   8,   8,   16,  24,  500, 504, 496,
+                                 488, 480, 984, 0,   1000, 1008, 1000, 8};
+  int frame = 0;
+  for (uint32_t mm : kDistances) {
+    RenderBackground(rainbow_fx, mm);
+    RenderBackground(beam_fx, mm);
+    ExpectSameFrame<Display::COLOR_MODE_65K>("Background", frame++,
+                                             rainbow_fx, beam_fx);
+  }
+}
+
+template <typename DrawTraits>
+void TestSprite(const char* name, RainbowFX& rainbow_fx, BeamFX& beam_fx) {
+  // Clipped at every edge but the left one, which neither clips.
+  int frame = 0;
+  for (const auto& sprite : kSprites) {
+    for (int y = -50; y < 130; y += 17) {
+      for (int x = 0; x < RainbowFX::kWidth; x += 23) {
+        RenderBackground(rainbow_fx, frame);
+        RenderBackground(beam_fx, frame);
+        rainbow_fx.DrawSprite<DrawTraits>(sprite, x, y);
+        beam_fx.DrawSprite<DrawTraits>(sprite, x, y);
+        ExpectSameFrame<Display::COLOR_MODE_65K>(name, frame++, rainbow_fx,
+                                                 beam_fx);
+      }
+    }
+  }
+}
+
+void TestSprites(RainbowFX& rainbow_fx, BeamFX& beam_fx) {
+  // Copied sprites erase the background, which a background layer would
+  // show through.
+  rainbow_fx.set_background_layer(false);
+  TestSprite<RainbowFX::DefaultDrawTraits>("Default", rainbow_fx, beam_fx);
+  rainbow_fx.set_background_layer(RainbowFX::kBackgroundLayer);
+  TestSprite<RainbowFX::BlendDrawTraits>("Blend", rainbow_fx, beam_fx);
+  TestSprite<RainbowFX::BlendDrawTraits1X>("Blend1X", rainbow_fx, beam_fx);
+  TestSprite<RainbowFX::SpanDrawTraits>("Span", rainbow_fx, beam_fx);
+  TestSprite<RainbowFX::SpanDrawTraits1X>("Span1X", rainbow_fx, beam_fx);
+}
+
+void TestText(RainbowFX& rainbow_fx, BeamFX& beam_fx) {
+  // RainbowFX doesn't clip text, so it has to fit.
+  const char* kTexts[] = {"0", "42", "1234", "98765"};
+  int frame = 0;
+  for (const char* text : kTexts) {
+    uint16_t w, h;
+    rainbow_fx.MeasureText(text, w, h);
+    for (int y = 0; y + h <= RainbowFX::kHeight; y += 5) {
+      for (int x = 0; x + w <= RainbowFX::kWidth; x += 7) {
+        RenderBackground(rainbow_fx, frame);
+        RenderBackground(beam_fx, frame);
+        rainbow_fx.DrawText(text, x, y);
+        beam_fx.DrawText(text, x, y);
+        ExpectSameFrame<Display::COLOR_MODE_65K>("Text", frame++, rainbow_fx,
+                                                 beam_fx);
+      }
+    }
+  }
+}
+
+void TestPalette(RainbowFX& rainbow_fx, BeamFX& beam_fx) {
+  for (int amount = 0; amount < 256; amount += 51) {
+    rainbow_fx.FadePalette(amount, 0x203040);
+    beam_fx.FadePalette(amount, 0x203040);
+    Render(rainbow_fx, 1234);
+    Render(beam_fx, 1234);
+    ExpectSameFrame<Display::COLOR_MODE_65K>("Fade", amount, rainbow_fx,
+                                             beam_fx);
+  }
+  rainbow_fx.SetPalette(kPalette);
+  beam_fx.SetPalette(kPalette);
+
+  // Fading out and back restores the animated palette, not the default one.
+  auto cycled = kPalette;
+  std::rotate(cycled.begin() + 1, cycled.begin() + 4, cycled.begin() + 5);
+  rainbow_fx.CyclePalette(1, 4);
+  rainbow_fx.FadePalette(128);
+  rainbow_fx.FadePalette(0);
+  beam_fx.SetPalette(cycled);
+  Render(rainbow_fx, 1234);
+  Render(beam_fx, 1234);
+  ExpectSameFrame<Display::COLOR_MODE_65K>("Unfade", 0, rainbow_fx, beam_fx);
+  rainbow_fx.SetPalette(kPalette);
+  beam_fx.SetPalette(kPalette);
+}
+
+void TestDroppedItems(BeamFX& beam_fx) {
+  beam_fx.Clear();
+  uint32_t dropped = beam_fx.dropped_items();
+  for (size_t i = 0; i < BeamFX::kMaxItems + 3; i++)
+    beam_fx.DrawSprite(kSprites[1], 0, 0);
+  if (beam_fx.dropped_items() - dropped != 3) {
+    fprintf(stderr, "expected 3 dropped items, got %u\n",
+            beam_fx.dropped_items() - dropped);
+    g_failures++;
+  }
+}
+
+}  // namespace
+
+int main() {
+  auto rainbow_fx = std::unique_ptr<RainbowFX>(new RainbowFX());
+  auto beam_fx = std::unique_ptr<BeamFX>(new BeamFX());
+  TestScene(*rainbow_fx, *beam_fx);
+  TestBackground(*rainbow_fx, *beam_fx);
+  TestSprites(*rainbow_fx, *beam_fx);
+  TestText(*rainbow_fx, *beam_fx);
+  TestPalette(*rainbow_fx, *beam_fx);
+  TestDroppedItems(*beam_fx);
+  return TestResult("BeamFX matches RainbowFX");
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// Minimal wall clock microbenchmark harness for the host build.
+struct BenchmarkResult {
+  const char* name;
+  size_t pixels;
+  double min_ns;
+  double median_ns;
+  double p99_ns;
+};
+
+void PrintBenchmarkHeader();
+void PrintBenchmarkResult(const BenchmarkResult& result);
+
+// Number of timed iterations per benchmark. Can be changed from the command
+// line.
+extern int g_benchmark_iterations;
+
+// Times |lambda| and reports the distribution of per-call times. |pixels| is
+// the number of pixels one call processes and is used for the ns/pixel column.
+template <typename Lambda>
+BenchmarkResult RunBenchmark(const char* name,
+                             size_t pixels,
+                             Lambda&& lambda) {
+  using Clock = std::chrono::steady_clock;
+  // Warm up caches and branch predictors.
+  for (int i = 0; i < g_benchmark_iterations / 10 + 1; i++)
+    lambda();
+
+  std::vector<double> samples(g_benchmark_iterations);
+  for (auto& sample : samples) {
+    auto start = Clock::now();
+    lambda();
+    auto end = Clock::now();
+    sample = std::chrono::duration<double, std::nano>(end - start).count();
+  }
+  std::sort(samples.begin(), samples.end());
+
+  BenchmarkResult result;
+  result.name = name;
+  result.pixels = pixels;
+  result.min_ns = samples.front();
+  result.median_ns = samples[samples.size() / 2];
+  result.p99_ns = samples[samples.size() * 99 / 100];
+  PrintBenchmarkResult(result);
+  return result;
+}
@@ -0,0 +1,272 @@
+// Checks that the VL53L1X driver keeps its calibration in flash once it has
+// calibrated, applies it on the next boot so that the first measurement
+// skips calibrating, and falls back to calibrating when what's kept is for
+// another layout or part, or the sensor fails with it.
+
+#include "calibration_store.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "distance_sensor.h"
+#include "i2c_host.h"
+#include "nvs_host.h"
+#include "test_util.h"
+#include "third_party/VL53L1_register_map.h"
+
+namespace {
+
+// The VL53L1X driver's key and layout tag.
+constexpr char kCalibrationKey[] = "vl53l1x";
+constexpr uint32_t kCalibrationTag = 0x564c0001;
+
+constexpr uint16_t kFastOscFrequency = 0xb000;
+constexpr uint16_t kOuterOffsetMM = 0x0010;
+// What the sensor leaves in the VHV and phasecal registers after its first
+// measurement.
+constexpr uint8_t kVHVInit = 0xa5;
+constexpr uint8_t kVHVTimeout = 0x02;
+constexpr uint8_t kVCSELStart = 0x0c;
+
+void SetRegister16(uint16_t reg, uint16_t value) {
+  uint8_t* registers = GetI2CRegisters();
+  registers[reg] = value >> 8;
+  registers[reg + 1] = value & 0xff;
+}
+
+uint16_t GetRegister16(uint16_t reg) {
+  uint8_t* registers = GetI2CRegisters();
+  return (registers[reg] << 8) | registers[reg + 1];
+}
+
+// A freshly reset part with the given oscillator frequency, which has
+// calibrated and has a range ready once ranging starts.
+void ResetSensor(uint16_t fast_osc_frequency) {
+  uint8_t* registers = GetI2CRegisters();
+  memset(registers, 0, 0x10000);
+  SetRegister16(VL53L1_IDENTIFICATION__MODEL_ID, 0xeacc);
+  registers[VL53L1_FIRMWARE__SYSTEM_STATUS] = 0x01;
+  SetRegister16(VL53L1_OSC_MEASURED__FAST_OSC__FREQUENCY, fast_osc_frequency);
+  SetRegister16(VL53L1_RESULT__OSC_CALIBRATE_VAL, 0x0300);
+  SetRegister16(VL53L1_MM_CONFIG__OUTER_OFFSET_MM, kOuterOffsetMM);
+  registers[VL53L1_VHV_CONFIG__INIT] = kVHVInit;
+  registers[VL53L1_VHV_CONFIG__TIMEOUT_MACROP_LOOP_BOUND] = kVHVTimeout;
+  registers[VL53L1_PHASECAL_RESULT__VCSEL_START] = kVCSELStart;
+  registers[VL53L1_RESULT__RANGE_STATUS] = 9;
+  registers[VL53L1_RESULT__STREAM_COUNT] = 1;
+  ResetI2CBusStats();
+}
+
+// Whether the VHV and phasecal results are applied.
+void ExpectCalibrated() {
+  uint8_t* registers = GetI2CRegisters();
+  EXPECT_EQ(kVHVInit & 0x7f, registers[VL53L1_VHV_CONFIG__INIT]);
+  EXPECT_EQ((kVHVTimeout & 0x03) + (3 << 2),
+            registers[VL53L1_VHV_CONFIG__TIMEOUT_MACROP_LOOP_BOUND]);
+  EXPECT_EQ(0x01, registers[VL53L1_PHASECAL_CONFIG__OVERRIDE]);
+  EXPECT_EQ(kVCSELStart, registers[VL53L1_CAL_CONFIG__VCSEL_START]);
+}
+
+// Polls once with no range ready.
+void PollNotReady(DistanceSensor& sensor) {
+  uint8_t* registers = GetI2CRegisters();
+  registers[VL53L1_GPIO__TIO_HV_STATUS] = 0x01;
+  uint32_t distance_mm;
+  EXPECT_EQ(false, sensor.GetDistanceMM(distance_mm));
+  registers[VL53L1_GPIO__TIO_HV_STATUS] = 0x00;
+}
+
+bool HasStoredCalibration() {
+  uint8_t data[kMaxCalibrationSize];
+  // The driver's layout is 10 bytes.
+  return LoadCalibration(kCalibrationKey, kCalibrationTag, data, 10);
+}
+
+// With nothing in flash, the first measurement calibrates, and the next
+// SaveCalibration() stores it, once.
+void TestColdBoot() {
+  ResetNVS();
+  ResetSensor(kFastOscFrequency);
+  auto sensor = DistanceSensor::Create();
+  if (!sensor) {
+    fprintf(stderr, "VL53L1X not found on the emulated bus\n");
+    g_failures++;
+    return;
+  }
+  // The reset, the boot status, the identification and calibration, and
+  // the configuration.
+  EXPECT_EQ(5u, GetI2CBusStats().transactions);
+  EXPECT_EQ(kOuterOffsetMM * 4,
+            GetRegister16(VL53L1_ALGO__PART_TO_PART_RANGE_OFFSET_MM));
+  sensor->Start(100);
+  EXPECT_EQ(0x00, GetI2CRegisters()[VL53L1_PHASECAL_CONFIG__OVERRIDE]);
+
+  ResetI2CBusStats();
+  uint32_t distance_mm;
+  EXPECT_EQ(true, sensor->GetDistanceMM(distance_mm));
+  // Status, results, the calibration read and write, and the DSS update.
+  EXPECT_EQ(5u, GetI2CBusStats().transactions);
+  ExpectCalibrated();
+  EXPECT_EQ(0u, GetNVSStats().writes);
+
+  // Polling doesn't write flash.
+  PollNotReady(*sensor);
+  EXPECT_EQ(0u, GetNVSStats().writes);
+  EXPECT_EQ(true, sensor->SaveCalibration());
+  EXPECT_EQ(1u, GetNVSStats().writes);
+  EXPECT_EQ(true, HasStoredCalibration());
+  EXPECT_EQ(false, sensor->SaveCalibration());
+  EXPECT_EQ(true, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ(false, sensor->SaveCalibration());
+  EXPECT_EQ(1u, GetNVSStats().writes);
+}
+
+// With the calibration from the cold boot in flash, the factory values are
+// taken from it rather than read, and Start() applies the VHV and phasecal
+// results, so the first measurement is like any other.
+void TestWarmBoot() {
+  ResetSensor(kFastOscFrequency);
+  // Only the copy in flash has the offset.
+  SetRegister16(VL53L1_MM_CONFIG__OUTER_OFFSET_MM, 0);
+  auto sensor = DistanceSensor::Create();
+  auto boot = GetI2CBusStats();
+  EXPECT_EQ(5u, boot.transactions);
+  EXPECT_EQ(kOuterOffsetMM * 4,
+            GetRegister16(VL53L1_ALGO__PART_TO_PART_RANGE_OFFSET_MM));
+
+  // The warm boot reads less than the cold one.
+  ResetNVS();
+  ResetSensor(kFastOscFrequency);
+  sensor = DistanceSensor::Create();
+  auto cold_boot = GetI2CBusStats();
+  EXPECT_EQ(6u, cold_boot.starts - boot.starts);
+  EXPECT_EQ(true, cold_boot.bytes > boot.bytes);
+  uint32_t distance_mm;
+  sensor->Start(100);
+  sensor->GetDistanceMM(distance_mm);
+  sensor->SaveCalibration();
+
+  ResetSensor(kFastOscFrequency);
+  sensor = DistanceSensor::Create();
+  sensor->Start(100);
+  ExpectCalibrated();
+  EXPECT_EQ(0x40, GetI2CRegisters()[VL53L1_SYSTEM__MODE_START]);
+  ResetI2CBusStats();
+  EXPECT_EQ(true, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ(3u, GetI2CBusStats().transactions);
+  // The calibration in flash is unchanged.
+  EXPECT_EQ(false, sensor->SaveCalibration());
+  EXPECT_EQ(1u, GetNVSStats().writes);
+
+  // Stopping restores the VHV and phasecal config, and starting again
+  // applies the results anew.
+  sensor->Stop();
+  EXPECT_EQ(kVHVInit, GetI2CRegisters()[VL53L1_VHV_CONFIG__INIT]);
+  EXPECT_EQ(0x00, GetI2CRegisters()[VL53L1_PHASECAL_CONFIG__OVERRIDE]);
+  sensor->Start(100);
+  ExpectCalibrated();
+}
+
+// A calibration for another part, told by its oscillator frequency, or in
+// another layout is ignored, and replaced once the sensor has calibrated.
+void TestMismatch() {
+  ResetSensor(kFastOscFrequency + 1);
+  auto sensor = DistanceSensor::Create();
+  // The factory values are read in a transaction of their own.
+  EXPECT_EQ(6u, GetI2CBusStats().transactions);
+  EXPECT_EQ(kOuterOffsetMM * 4,
+            GetRegister16(VL53L1_ALGO__PART_TO_PART_RANGE_OFFSET_MM));
+  sensor->Start(100);
+  EXPECT_EQ(0x00, GetI2CRegisters()[VL53L1_PHASECAL_CONFIG__OVERRIDE]);
+  uint32_t distance_mm;
+  ResetI2CBusStats();
+  EXPECT_EQ(true, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ(5u, GetI2CBusStats().transactions);
+  uint32_t writes = GetNVSStats().writes;
+  EXPECT_EQ(true, sensor->SaveCalibration());
+  EXPECT_EQ(writes + 1, GetNVSStats().writes);
+
+  uint8_t data[10] = {};
+  EXPECT_EQ(true, StoreCalibration(kCalibrationKey, kCalibrationTag - 1, data,
+                                   sizeof(data)));
+  EXPECT_EQ(false, HasStoredCalibration());
+  ResetSensor(kFastOscFrequency);
+  sensor = DistanceSensor::Create();
+  EXPECT_EQ(5u, GetI2CBusStats().transactions);
+  sensor->Start(100);
+  EXPECT_EQ(0x00, GetI2CRegisters()[VL53L1_PHASECAL_CONFIG__OVERRIDE]);
+}
+
+// If the first measurement with a calibration from flash reports a VHV
+// failure, the sensor is restarted to calibrate afresh, and the calibration
+// erased by the next SaveCalibration(). Other failures don't count against
+// it.
+void TestRejected() {
+  ResetNVS();
+  ResetSensor(kFastOscFrequency);
+  auto sensor = DistanceSensor::Create();
+  uint32_t distance_mm;
+  sensor->Start(100);
+  sensor->GetDistanceMM(distance_mm);
+  sensor->SaveCalibration();
+
+  ResetSensor(kFastOscFrequency);
+  sensor = DistanceSensor::Create();
+  sensor->Start(100);
+  ExpectCalibrated();
+  uint8_t* registers = GetI2CRegisters();
+  registers[VL53L1_RESULT__RANGE_STATUS] = 4;  // MSRCNOTARGET
+  EXPECT_EQ(false, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ(true, HasStoredCalibration());
+  registers[VL53L1_RESULT__RANGE_STATUS] = 3;  // NOVHVVALUEFOUND
+  EXPECT_EQ(false, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ(true, HasStoredCalibration());
+  EXPECT_EQ(true, sensor->SaveCalibration());
+  EXPECT_EQ(false, HasStoredCalibration());
+  EXPECT_EQ(kVHVInit, registers[VL53L1_VHV_CONFIG__INIT]);
+  EXPECT_EQ(0x00, registers[VL53L1_PHASECAL_CONFIG__OVERRIDE]);
+  EXPECT_EQ(0x40, registers[VL53L1_SYSTEM__MODE_START]);
+
+  registers[VL53L1_RESULT__RANGE_STATUS] = 9;
+  ResetI2CBusStats();
+  EXPECT_EQ(true, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ(5u, GetI2CBusStats().transactions);
+  ExpectCalibrated();
+  EXPECT_EQ(true, sensor->SaveCalibration());
+  EXPECT_EQ(true, HasStoredCalibration());
+
+  // Once a range has completed with it, the calibration stays.
+  ResetSensor(kFastOscFrequency);
+  sensor = DistanceSensor::Create();
+  sensor->Start(100);
+  EXPECT_EQ(true, sensor->GetDistanceMM(distance_mm));
+  registers[VL53L1_RESULT__RANGE_STATUS] = 3;
+  EXPECT_EQ(false, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ(false, sensor->SaveCalibration());
+  EXPECT_EQ(true, HasStoredCalibration());
+  EXPECT_EQ(0x01, registers[VL53L1_PHASECAL_CONFIG__OVERRIDE]);
+
+  // If the sensor has calibrated again by the next SaveCalibration(), the
+  // new calibration replaces the old one rather than it being erased.
+  ResetSensor(kFastOscFrequency);
+  sensor = DistanceSensor::Create();
+  sensor->Start(100);
+  registers[VL53L1_RESULT__RANGE_STATUS] = 3;
+  EXPECT_EQ(false, sensor->GetDistanceMM(distance_mm));
+  registers[VL53L1_RESULT__RANGE_STATUS] = 9;
+  EXPECT_EQ(true, sensor->GetDistanceMM(distance_mm));
+  uint32_t writes = GetNVSStats().writes;
+  EXPECT_EQ(true, sensor->SaveCalibration());
+  EXPECT_EQ(writes + 1, GetNVSStats().writes);
+  EXPECT_EQ(true, HasStoredCalibration());
+}
+
+}  // namespace
+
+int main() {
+  TestColdBoot();
+  TestWarmBoot();
+  TestMismatch();
+  TestRejected();
+  return TestResult("Calibration store OK");
+}
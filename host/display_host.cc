@@ -0,0 +1,376 @@
+#include "display_host.h"
+
+#include <chrono>
+
+#include "util.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+DisplayStats g_stats;
+std::array<uint16_t, Display::kWidth * Display::kHeight> g_framebuffer;
+
+// Command decoder state.
+uint8_t g_command = 0;
+uint8_t g_args[16];
+size_t g_arg_count = 0;
+
+// Write window and cursor.
+uint8_t g_column_start = 0;
+uint8_t g_column_end = Display::kWidth - 1;
+uint8_t g_row_start = 0;
+uint8_t g_row_end = Display::kHeight - 1;
+uint8_t g_column = 0;
+uint8_t g_row = 0;
+bool g_fill_enabled = false;
+bool g_color_256 = false;
+
+// Emulated bus timing: when the last queued transfer ends, and when each
+// chunk buffer's transfer ends.
+uint32_t g_spi_clock_hz = 0;
+Clock::time_point g_bus_free;
+std::array<Clock::time_point, 2> g_chunk_done;
+
+// Data arrives a byte at a time; pixels are big endian.
+uint8_t g_pixel_hi = 0;
+bool g_have_pixel_hi = false;
+
+void WritePixel(uint16_t pixel) {
+  if (g_column < Display::kWidth && g_row < Display::kHeight)
+    g_framebuffer[g_row * Display::kWidth + g_column] = pixel;
+  if (g_column++ == g_column_end) {
+    g_column = g_column_start;
+    if (g_row++ == g_row_end)
+      g_row = g_row_start;
+  }
+}
+
+void FillRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint16_t color) {
+  for (int y = y0; y <= y1 && y < Display::kHeight; y++) {
+    for (int x = x0; x <= x1 && x < Display::kWidth; x++)
+      g_framebuffer[y * Display::kWidth + x] = color;
+  }
+}
+
+uint16_t Color(const uint8_t* rgb) {
+  // Drawing commands take 6 bit color components.
+  return ((rgb[0] >> 1) << 11) | ((rgb[1] & 0x3f) << 5) | (rgb[2] >> 1);
+}
+
+void CopyRect(uint8_t x0,
+              uint8_t y0,
+              uint8_t x1,
+              uint8_t y1,
+              uint8_t dst_x,
+              uint8_t dst_y) {
+  // Like the panel, copy in row order without handling overlap.
+  for (int y = y0; y <= y1; y++) {
+    for (int x = x0; x <= x1; x++) {
+      int dx = dst_x + x - x0;
+      int dy = dst_y + y - y0;
+      if (dx < Display::kWidth && dy < Display::kHeight) {
+        g_framebuffer[dy * Display::kWidth + dx] =
+            g_framebuffer[y * Display::kWidth + x];
+      }
+    }
+  }
+}
+
+void DecodeData(const uint32_t* data, size_t bytes) {
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+  if (g_color_256) {
+    for (size_t i = 0; i < bytes; i++)
+      WritePixel(ExpandRGB332(p[i]));
+    return;
+  }
+  for (size_t i = 0; i < bytes; i++) {
+    if (!g_have_pixel_hi) {
+      g_pixel_hi = p[i];
+      g_have_pixel_hi = true;
+    } else {
+      WritePixel((g_pixel_hi << 8) | p[i]);
+      g_have_pixel_hi = false;
+    }
+  }
+}
+
+// Queues a transfer of |bytes| on the emulated bus and returns when it ends.
+Clock::time_point ReserveBus(size_t bytes) {
+  auto now = Clock::now();
+  if (!g_spi_clock_hz)
+    return g_bus_free = now;
+  auto duration = std::chrono::nanoseconds(uint64_t{bytes} * 8 * 1000000000 /
+                                           g_spi_clock_hz);
+  g_bus_free = std::max(now, g_bus_free) + duration;
+  return g_bus_free;
+}
+
+}  // namespace
+
+void SetEmulatedSPIClock(uint32_t hz) {
+  g_spi_clock_hz = hz;
+}
+
+const DisplayStats& GetDisplayStats() {
+  return g_stats;
+}
+
+void ResetDisplayStats() {
+  g_stats = DisplayStats();
+}
+
+const uint16_t* GetDisplayFramebuffer() {
+  return g_framebuffer.data();
+}
+
+SSD1331::SSD1331() {
+  WriteCommand(CMD_SETREMAP);
+  WriteCommand(Remap());
+  Clear();
+}
+
+SSD1331::~SSD1331() = default;
+
+void SSD1331::SetColorMode(ColorMode mode) {
+  color_mode_ = mode;
+  WriteCommand(CMD_SETREMAP);
+  WriteCommand(Remap());
+  Flush();
+}
+
+void SSD1331::Clear() {
+  WriteCommand(CMD_CLEAR);
+  WriteCommand(0);
+  WriteCommand(0);
+  WriteCommand(kWidth - 1);
+  WriteCommand(kHeight - 1);
+  Flush();
+}
+
+void SSD1331::Fill(uint8_t r, uint8_t g, uint8_t b) {
+  WriteCommand(CMD_FILL);
+  WriteCommand(0x01);
+
+  WriteCommand(CMD_DRAWRECT);
+  WriteCommand(0);
+  WriteCommand(0);
+  WriteCommand(kWidth - 1);
+  WriteCommand(kHeight - 1);
+  WriteCommand(r);
+  WriteCommand(g);
+  WriteCommand(b);
+  WriteCommand(r);
+  WriteCommand(g);
+  WriteCommand(b);
+  Flush();
+}
+
+void SSD1331::Execute(const DrawCommand* commands, size_t count) {
+  if (!count)
+    return;
+  WriteCommand(CMD_FILL);
+  WriteCommand(0x01);
+  for (size_t i = 0; i < count; i++) {
+    const DrawCommand& command = commands[i];
+    if (command.type == DrawCommand::kCopy) {
+      WriteCommand(CMD_COPY);
+      WriteCommand(command.rect.x0);
+      WriteCommand(command.rect.y0);
+      WriteCommand(command.rect.x1 - 1);
+      WriteCommand(command.rect.y1 - 1);
+      WriteCommand(command.x);
+      WriteCommand(command.y);
+    } else {
+      // In 256 color mode, fill with the color that the pixel data would
+      // have shown.
+      uint16_t color = command.color;
+      if (color_mode_ == COLOR_MODE_256)
+        color = ExpandRGB332(UnexplodeRGB332(ExplodeRGB565(color)));
+      uint8_t r = (color >> 11) << 1;
+      uint8_t g = (color >> 5) & 0x3f;
+      uint8_t b = (color & 0x1f) << 1;
+      WriteCommand(CMD_DRAWRECT);
+      WriteCommand(command.rect.x0);
+      WriteCommand(command.rect.y0);
+      WriteCommand(command.rect.x1 - 1);
+      WriteCommand(command.rect.y1 - 1);
+      WriteCommand(r);
+      WriteCommand(g);
+      WriteCommand(b);
+      WriteCommand(r);
+      WriteCommand(g);
+      WriteCommand(b);
+    }
+    Flush();
+    g_stats.accelerated_commands++;
+  }
+}
+
+void SSD1331::Enable(bool enabled) {
+  if (enabled) {
+    WriteCommand(CMD_POWERMODE);
+    WriteCommand(0x0B);
+    WriteCommand(CMD_DISPLAYON);
+  } else {
+    WriteCommand(CMD_DISPLAYOFF);
+    WriteCommand(CMD_POWERMODE);
+    WriteCommand(0x1A);
+  }
+  Flush();
+}
+
+void SSD1331::WriteCommand(uint16_t cmd) {
+  // Commands are decoded right away but counted as one transfer when they're
+  // sent, like on the device.
+  if (command_bytes_ == kChunkSizeBytes)
+    SendCommands();
+  command_bytes_++;
+  g_stats.command_bytes++;
+
+  if (!g_arg_count && !g_command) {
+    g_command = static_cast<uint8_t>(cmd);
+  } else {
+    g_args[g_arg_count++] = static_cast<uint8_t>(cmd);
+  }
+
+  size_t expected_args = 0;
+  switch (g_command) {
+    case CMD_SETCOLUMN:
+    case CMD_SETROW:
+      expected_args = 2;
+      break;
+    case CMD_CLEAR:
+      expected_args = 4;
+      break;
+    case CMD_DRAWRECT:
+      expected_args = 10;
+      break;
+    case CMD_DRAWLINE:
+      expected_args = 7;
+      break;
+    case CMD_COPY:
+      expected_args = 6;
+      break;
+    case CMD_DIMWINDOW:
+      expected_args = 4;
+      break;
+    case CMD_FILL:
+    case CMD_SETREMAP:
+    case CMD_STARTLINE:
+    case CMD_DISPLAYOFFSET:
+    case CMD_SETMULTIPLEX:
+    case CMD_SETMASTER:
+    case CMD_POWERMODE:
+    case CMD_PRECHARGE:
+    case CMD_CLOCKDIV:
+    case CMD_PRECHARGEA:
+    case CMD_PRECHARGEB:
+    case CMD_PRECHARGEC:
+    case CMD_PRECHARGELEVEL:
+    case CMD_VCOMH:
+    case CMD_MASTERCURRENT:
+    case CMD_CONTRASTA:
+    case CMD_CONTRASTB:
+    case CMD_CONTRASTC:
+      expected_args = 1;
+      break;
+  }
+  if (g_arg_count < expected_args)
+    return;
+
+  switch (g_command) {
+    case CMD_SETCOLUMN:
+      g_column_start = g_column = g_args[0];
+      g_column_end = g_args[1];
+      break;
+    case CMD_SETROW:
+      g_row_start = g_row = g_args[0];
+      g_row_end = g_args[1];
+      break;
+    case CMD_CLEAR:
+      FillRect(g_args[0], g_args[1], g_args[2], g_args[3], 0);
+      break;
+    case CMD_COPY:
+      CopyRect(g_args[0], g_args[1], g_args[2], g_args[3], g_args[4],
+               g_args[5]);
+      break;
+    case CMD_FILL:
+      g_fill_enabled = g_args[0] & 0x01;
+      break;
+    case CMD_SETREMAP:
+      g_color_256 = !(g_args[0] & 0b11000000);
+      break;
+    case CMD_DRAWRECT:
+      if (g_fill_enabled)
+        FillRect(g_args[0], g_args[1], g_args[2], g_args[3], Color(&g_args[7]));
+      break;
+  }
+  g_command = 0;
+  g_arg_count = 0;
+  g_have_pixel_hi = false;
+}
+
+void SSD1331::SendCommands() {
+  if (!command_bytes_)
+    return;
+  WaitForIdle();
+  ReserveBus(command_bytes_);
+  g_stats.transactions++;
+  command_bytes_ = 0;
+}
+
+void SSD1331::WriteData(const uint32_t* data, size_t bytes) {
+  SendCommands();
+  WaitForIdle();
+  ReserveBus(bytes);
+  g_stats.data_bytes += bytes;
+  g_stats.transactions++;
+  DecodeData(data, bytes);
+}
+
+uint32_t* SSD1331::AcquireChunk() {
+  // Chunks complete once the emulated bus is done with them.
+  auto update = [this] {
+    auto now = Clock::now();
+    while (completed_chunks_ != submitted_chunks_ &&
+           now >= g_chunk_done[completed_chunks_ % 2]) {
+      completed_chunks_++;
+    }
+  };
+  update();
+  if (submitted_chunks_ - completed_chunks_ == 2) {
+    scanout_stats_.render_stalls++;
+    while (submitted_chunks_ - completed_chunks_ == 2)
+      update();
+  }
+  return &pixels_[(submitted_chunks_ % 2) * kChunkWords];
+}
+
+void SSD1331::SubmitChunk(size_t bytes, bool first) {
+  SendCommands();
+  scanout_stats_.chunks++;
+  if (g_spi_clock_hz && !first && Clock::now() >= g_bus_free)
+    scanout_stats_.transfer_stalls++;
+  size_t index = submitted_chunks_ % 2;
+  g_chunk_done[index] = ReserveBus(bytes);
+  g_stats.data_bytes += bytes;
+  g_stats.transactions++;
+  // The emulated panel memory is updated right away; only the timing is
+  // emulated.
+  DecodeData(&pixels_[index * kChunkWords], bytes);
+  submitted_chunks_++;
+  if (!async_scanout_)
+    WaitForIdle();
+}
+
+void SSD1331::Flush() {
+  SendCommands();
+  WaitForIdle();
+}
+
+void SSD1331::WaitForIdle() {
+  while (Clock::now() < g_bus_free) {
+  }
+  completed_chunks_ = submitted_chunks_;
+}
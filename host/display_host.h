@@ -0,0 +1,27 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "display.h"
+
+// Host implementation of the SSD1331 transport. Instead of talking to the
+// panel, commands and pixel data are interpreted by a small emulator so the
+// resulting image and the number of bytes that would have gone over SPI can be
+// inspected.
+struct DisplayStats {
+  uint32_t command_bytes = 0;
+  uint32_t data_bytes = 0;
+  uint32_t transactions = 0;
+  uint32_t accelerated_commands = 0;
+};
+
+const DisplayStats& GetDisplayStats();
+void ResetDisplayStats();
+
+// Contents of the emulated panel memory in native RGB565, row-major.
+const uint16_t* GetDisplayFramebuffer();
+
+// Makes every transfer occupy the emulated bus for as long as it would take
+// at |hz|, so that scan-out waits for it like on the device. 0 (the default)
+// makes transfers instant.
+void SetEmulatedSPIClock(uint32_t hz);
@@ -0,0 +1,69 @@
+#include "heap_host.h"
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <new>
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_frees{0};
+
+void* Allocate(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void* AllocateAligned(size_t size, std::align_val_t alignment) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  size_t align = static_cast<size_t>(alignment);
+  // aligned_alloc() wants a multiple of the alignment.
+  if (void* p = aligned_alloc(align, (size + align - 1) / align * align))
+    return p;
+  throw std::bad_alloc();
+}
+
+void Free(void* p) {
+  if (!p)
+    return;
+  g_frees.fetch_add(1, std::memory_order_relaxed);
+  free(p);
+}
+
+}  // namespace
+
+HeapStats GetHeapStats() {
+  HeapStats stats;
+  stats.allocations = g_allocations.load(std::memory_order_relaxed);
+  stats.frees = g_frees.load(std::memory_order_relaxed);
+  return stats;
+}
+
+// The array and nothrow forms forward to these. The sized deletes are
+// defined too, since which of them the compiler calls depends on its flags.
+void* operator new(size_t size) {
+  return Allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* p) noexcept {
+  Free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+  Free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  Free(p);
+}
+
+void operator delete(void* p, size_t, std::align_val_t) noexcept {
+  Free(p);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdint.h>
+
+// Counts heap operations in the host build, by replacing the global operator
+// new and delete, so that tests can check that a code path doesn't allocate.
+// The SDK shims allocate with them where the SDK would malloc().
+struct HeapStats {
+  uint64_t allocations = 0;
+  uint64_t frees = 0;
+};
+
+// Totals since startup, over all threads.
+HeapStats GetHeapStats();
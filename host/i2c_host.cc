@@ -0,0 +1,169 @@
+#include "i2c_host.h"
+
+#include <array>
+#include <chrono>
+
+// Like the SDK's, a list with a node allocated for every command, which
+// running it leaves in place.
+struct HostI2CCommands {
+  enum class Type { kStart, kStop, kWrite, kRead };
+  struct Command {
+    Type type;
+    // The byte to write, unless |data| is set: where to write from or read
+    // to.
+    uint8_t value;
+    uint8_t* data;
+    size_t size;
+    Command* next;
+  };
+  Command* head = nullptr;
+  Command* tail = nullptr;
+
+  ~HostI2CCommands() {
+    while (head) {
+      Command* next = head->next;
+      delete head;
+      head = next;
+    }
+  }
+
+  void Append(Type type, uint8_t value, uint8_t* data, size_t size) {
+    Command* command = new Command{type, value, data, size, nullptr};
+    if (tail) {
+      tail->next = command;
+    } else {
+      head = command;
+    }
+    tail = command;
+  }
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+I2CBusStats g_stats;
+uint32_t g_i2c_clock_hz = 0;
+std::array<uint8_t, 0x10000> g_registers;
+// Survives repeated STARTs, which is how a register is read: write the
+// index, then read from it.
+uint16_t g_index = 0;
+
+}  // namespace
+
+const I2CBusStats& GetI2CBusStats() {
+  return g_stats;
+}
+
+void ResetI2CBusStats() {
+  g_stats = I2CBusStats();
+}
+
+uint8_t* GetI2CRegisters() {
+  return g_registers.data();
+}
+
+void SetEmulatedI2CClock(uint32_t hz) {
+  g_i2c_clock_hz = hz;
+}
+
+// There is one bus, the emulated device acknowledges every byte, and
+// transactions don't time out, so the ACK and port arguments go unused.
+i2c_cmd_handle_t i2c_cmd_link_create() {
+  return new HostI2CCommands();
+}
+
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd) {
+  delete cmd;
+}
+
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd) {
+  cmd->Append(HostI2CCommands::Type::kStart, 0, nullptr, 0);
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd) {
+  cmd->Append(HostI2CCommands::Type::kStop, 0, nullptr, 0);
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd,
+                                uint8_t data,
+                                bool /* ack_en */) {
+  cmd->Append(HostI2CCommands::Type::kWrite, data, nullptr, 1);
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd,
+                           uint8_t* data,
+                           size_t data_len,
+                           bool /* ack_en */) {
+  cmd->Append(HostI2CCommands::Type::kWrite, 0, data, data_len);
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd,
+                               uint8_t* data,
+                               i2c_ack_type_t /* ack */) {
+  cmd->Append(HostI2CCommands::Type::kRead, 0, data, 1);
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd,
+                          uint8_t* data,
+                          size_t data_len,
+                          i2c_ack_type_t /* ack */) {
+  cmd->Append(HostI2CCommands::Type::kRead, 0, data, data_len);
+  return ESP_OK;
+}
+
+esp_err_t i2c_master_cmd_begin(i2c_port_t /* i2c_num */,
+                               i2c_cmd_handle_t cmd,
+                               TickType_t /* ticks_to_wait */) {
+  using Type = HostI2CCommands::Type;
+  auto start = Clock::now();
+  uint32_t clocks = 0;
+  g_stats.transactions++;
+  bool address_byte = false;
+  size_t index_bytes = 0;
+  for (const auto* command = cmd->head; command; command = command->next) {
+    switch (command->type) {
+      case Type::kStart:
+        clocks++;
+        g_stats.starts++;
+        address_byte = true;
+        index_bytes = 0;
+        break;
+      case Type::kStop:
+        clocks++;
+        break;
+      case Type::kWrite:
+        for (size_t i = 0; i < command->size; i++) {
+          uint8_t value = command->data ? command->data[i] : command->value;
+          g_stats.bytes++;
+          clocks += 9;
+          if (address_byte) {
+            address_byte = false;
+          } else if (index_bytes < 2) {
+            g_index = index_bytes++ ? (g_index & 0xff00) | value : value << 8;
+          } else {
+            g_registers[g_index++] = value;
+          }
+        }
+        break;
+      case Type::kRead:
+        g_stats.bytes += command->size;
+        clocks += command->size * 9;
+        for (size_t i = 0; i < command->size; i++)
+          command->data[i] = g_registers[g_index++];
+        break;
+    }
+  }
+  if (g_i2c_clock_hz) {
+    auto end = start + std::chrono::nanoseconds(uint64_t{clocks} * 1000000000 /
+                                                g_i2c_clock_hz);
+    while (Clock::now() < end) {
+    }
+  }
+  return ESP_OK;
+}
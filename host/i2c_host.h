@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <driver/i2c.h>
+
+// Host implementation of the SDK's I2C master driver. Command links run
+// against an emulated device at any address, with a 64 KB register file and
+// 16 bit register indices that auto-increment, like the VL53L1X's: a write
+// sets the index with its first two bytes and writes the rest, and a read
+// continues from the index.
+struct I2CBusStats {
+  // Calls to i2c_master_cmd_begin(), each ending with a STOP.
+  uint32_t transactions = 0;
+  // START and repeated START conditions.
+  uint32_t starts = 0;
+  // Including the address bytes.
+  uint32_t bytes = 0;
+};
+
+const I2CBusStats& GetI2CBusStats();
+void ResetI2CBusStats();
+
+// The emulated device's registers, for tests to set up and check.
+uint8_t* GetI2CRegisters();
+
+// Makes every transaction busy-wait for as long as it would take on the bus
+// at |hz|, 9 clocks per byte and one per START or STOP, like the SDK's bit
+// banged driver. 0 (the default) makes transactions instant.
+void SetEmulatedI2CClock(uint32_t hz);
@@ -0,0 +1,345 @@
+// Checks that I2CTransaction merges and batches register accesses on the
+// emulated bus, can be resubmitted and skips accesses a register shadow makes
+// redundant, and the bus traffic and heap operations of the VL53L1X driver
+// per measurement.
+
+#include "i2c_transaction.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "distance_sensor.h"
+#include "heap_host.h"
+#include "i2c_host.h"
+#include "register_shadow.h"
+#include "test_util.h"
+#include "third_party/VL53L1_register_map.h"
+
+namespace {
+
+constexpr uint8_t kAddress = 0x29;
+// The VL53L1X driver's DSS target, in MCPS.
+constexpr uint16_t kTargetRate = 0x0A00;
+
+// The bus traffic since the last call, as counted by the emulated bus, after
+// checking that I2CTransaction counted the same.
+I2CBusStats TakeBusStats() {
+  static I2CTransaction::Stats last;
+  I2CBusStats bus = GetI2CBusStats();
+  const auto& counted = I2CTransaction::stats();
+  EXPECT_EQ(bus.transactions, counted.transactions - last.transactions);
+  EXPECT_EQ(bus.starts, counted.starts - last.starts);
+  EXPECT_EQ(bus.bytes, counted.bytes - last.bytes);
+  last = counted;
+  ResetI2CBusStats();
+  return bus;
+}
+
+void TestSingleAccesses() {
+  uint8_t* registers = GetI2CRegisters();
+  TakeBusStats();
+
+  I2CTransaction write(kAddress);
+  write.Write16(0x1234, 0xbeef);
+  EXPECT_EQ(true, write.Submit());
+  EXPECT_EQ(0xbe, registers[0x1234]);
+  EXPECT_EQ(0xef, registers[0x1235]);
+  auto stats = TakeBusStats();
+  EXPECT_EQ(1u, stats.transactions);
+  EXPECT_EQ(1u, stats.starts);
+  // Address, index and value.
+  EXPECT_EQ(5u, stats.bytes);
+
+  // Reading writes the index, then readdresses the device with a repeated
+  // START.
+  uint8_t value = 0;
+  I2CTransaction read(kAddress);
+  read.Read(0x1235, &value, 1);
+  EXPECT_EQ(true, read.Submit());
+  EXPECT_EQ(0xef, value);
+  stats = TakeBusStats();
+  EXPECT_EQ(1u, stats.transactions);
+  EXPECT_EQ(2u, stats.starts);
+  EXPECT_EQ(5u, stats.bytes);
+
+  // Nothing to send.
+  I2CTransaction empty(kAddress);
+  EXPECT_EQ(true, empty.Submit());
+  EXPECT_EQ(0u, TakeBusStats().transactions);
+}
+
+void TestBursts() {
+  uint8_t* registers = GetI2CRegisters();
+  for (int i = 0; i < 16; i++)
+    registers[0x200 + i] = 0x10 + i;
+  TakeBusStats();
+
+  // Reads of consecutive registers become one burst, even into separate
+  // buffers.
+  uint8_t head[2] = {};
+  uint8_t tail[3] = {};
+  I2CTransaction reads(kAddress);
+  reads.Read(0x200, head, sizeof(head));
+  reads.Read(0x202, tail, sizeof(tail));
+  reads.Submit();
+  EXPECT_EQ(0x10, head[0]);
+  EXPECT_EQ(0x11, head[1]);
+  EXPECT_EQ(0x12, tail[0]);
+  EXPECT_EQ(0x14, tail[2]);
+  auto stats = TakeBusStats();
+  EXPECT_EQ(1u, stats.transactions);
+  EXPECT_EQ(2u, stats.starts);
+  EXPECT_EQ(4u + 5u, stats.bytes);
+
+  // So do writes.
+  I2CTransaction writes(kAddress);
+  writes.Write8(0x300, 1);
+  writes.Write16(0x301, 0x0203);
+  writes.Write32(0x303, 0x04050607);
+  writes.Submit();
+  for (int i = 0; i < 7; i++)
+    EXPECT_EQ(i + 1, registers[0x300 + i]);
+  stats = TakeBusStats();
+  EXPECT_EQ(1u, stats.transactions);
+  EXPECT_EQ(1u, stats.starts);
+  EXPECT_EQ(3u + 7u, stats.bytes);
+}
+
+void TestBatches() {
+  uint8_t* registers = GetI2CRegisters();
+  registers[0x400] = 0x42;
+  registers[0x410] = 0x43;
+  TakeBusStats();
+
+  // Separate accesses share one transaction, each after a repeated START.
+  // Going back to a register or changing direction starts a new access.
+  uint8_t first = 0;
+  uint8_t second = 0;
+  uint8_t again = 0;
+  I2CTransaction transaction(kAddress);
+  transaction.Read(0x400, &first, 1);
+  transaction.Write8(0x401, 0x55);
+  transaction.Read(0x410, &second, 1);
+  transaction.Read(0x400, &again, 1);
+  transaction.Write8(0x420, 0x66);
+  transaction.Write8(0x430, 0x77);
+  transaction.Submit();
+  EXPECT_EQ(0x42, first);
+  EXPECT_EQ(0x43, second);
+  EXPECT_EQ(0x42, again);
+  EXPECT_EQ(0x55, registers[0x401]);
+  EXPECT_EQ(0x66, registers[0x420]);
+  EXPECT_EQ(0x77, registers[0x430]);
+  auto stats = TakeBusStats();
+  EXPECT_EQ(1u, stats.transactions);
+  EXPECT_EQ(3u * 2 + 3u, stats.starts);
+}
+
+// A transaction can be submitted again, reading fresh values and writing the
+// current ones from WriteFrom() buffers. Only the first Submit() allocates,
+// to queue the STOP.
+void TestResubmit() {
+  uint8_t* registers = GetI2CRegisters();
+  TakeBusStats();
+
+  uint8_t value = 0;
+  uint8_t source[2] = {0x12, 0x34};
+  I2CTransaction transaction(kAddress);
+  transaction.Read(0x500, &value, 1);
+  transaction.WriteFrom(0x510, source, sizeof(source));
+  transaction.Write8(0x512, 0x56);
+  HeapStats heap;
+  for (uint8_t i = 0; i < 3; i++) {
+    registers[0x500] = 0x40 + i;
+    source[1] = 0x34 + i;
+    EXPECT_EQ(true, transaction.Submit());
+    EXPECT_EQ(0x40 + i, value);
+    EXPECT_EQ(0x12, registers[0x510]);
+    EXPECT_EQ(0x34 + i, registers[0x511]);
+    EXPECT_EQ(0x56, registers[0x512]);
+    if (!i)
+      heap = GetHeapStats();
+  }
+  EXPECT_EQ(heap.allocations, GetHeapStats().allocations);
+  auto stats = TakeBusStats();
+  EXPECT_EQ(3u, stats.transactions);
+  EXPECT_EQ(3u * 3, stats.starts);
+  EXPECT_EQ(3u * (5 + 6), stats.bytes);
+}
+
+// Through a shadow, unchanged writes are dropped and reads of known
+// registers served without touching the bus.
+void TestShadow() {
+  uint8_t* registers = GetI2CRegisters();
+  registers[0x600] = 0x11;
+  registers[0x601] = 0x22;
+  registers[0x610] = 0x33;
+  RegisterShadow shadow(0x600, 0x620);
+  shadow.SetVolatile(0x610);
+  TakeBusStats();
+  auto before = RegisterShadow::stats();
+
+  // Reads teach the shadow, except of the volatile register.
+  uint8_t values[2] = {};
+  uint8_t status = 0;
+  {
+    I2CTransaction transaction(kAddress, &shadow);
+    transaction.Read(0x600, values, sizeof(values));
+    transaction.Read(0x610, &status, 1);
+    transaction.Submit();
+  }
+  EXPECT_EQ(0x22, values[1]);
+  EXPECT_EQ(2u * 2, TakeBusStats().starts);
+  {
+    I2CTransaction transaction(kAddress, &shadow);
+    transaction.Read(0x600, values, sizeof(values));
+    transaction.Read(0x610, &status, 1);
+    EXPECT_EQ(0x11, values[0]);
+    transaction.Submit();
+  }
+  EXPECT_EQ(2u, TakeBusStats().starts);
+
+  // Only the changed register of the write is sent, as its own access.
+  {
+    I2CTransaction transaction(kAddress, &shadow);
+    transaction.Write8(0x600, 0x11);
+    transaction.Write8(0x601, 0x44);
+    transaction.Submit();
+  }
+  EXPECT_EQ(0x44, registers[0x601]);
+  auto stats = TakeBusStats();
+  EXPECT_EQ(1u, stats.starts);
+  EXPECT_EQ(4u, stats.bytes);
+  {
+    I2CTransaction transaction(kAddress, &shadow);
+    transaction.Write16(0x600, 0x1144);
+    transaction.Submit();
+  }
+  EXPECT_EQ(0u, TakeBusStats().transactions);
+
+  const auto& after = RegisterShadow::stats();
+  EXPECT_EQ(1u, after.reads_avoided - before.reads_avoided);
+  EXPECT_EQ(2u, after.writes_avoided - before.writes_avoided);
+  EXPECT_EQ(2u + 1 + 2, after.bytes_avoided - before.bytes_avoided);
+
+  // The check reads the whole range, finds the register the device changed
+  // and corrects the shadow.
+  registers[0x601] = 0x55;
+  registers[0x610] = 0x66;
+  EXPECT_EQ(1u, shadow.Verify(kAddress));
+  EXPECT_EQ(1u, after.mismatches - before.mismatches);
+  EXPECT_EQ(0u, shadow.Verify(kAddress));
+  EXPECT_EQ(true, shadow.Read(0x601, values, 1));
+  EXPECT_EQ(0x55, values[0]);
+  TakeBusStats();
+}
+
+void SetRegister16(uint16_t reg, uint16_t value) {
+  uint8_t* registers = GetI2CRegisters();
+  registers[reg] = value >> 8;
+  registers[reg + 1] = value & 0xff;
+}
+
+// A measurement is a status read, the results read, and the DSS update with
+// the interrupt clear, none of which touch the heap once the sensor is
+// running.
+void TestDistanceSensor() {
+  uint8_t* registers = GetI2CRegisters();
+  memset(registers, 0, 0x10000);
+  SetRegister16(VL53L1_IDENTIFICATION__MODEL_ID, 0xeacc);
+  registers[VL53L1_FIRMWARE__SYSTEM_STATUS] = 0x01;
+  SetRegister16(VL53L1_OSC_MEASURED__FAST_OSC__FREQUENCY, 0xb000);
+  SetRegister16(VL53L1_RESULT__OSC_CALIBRATE_VAL, 0x0300);
+  TakeBusStats();
+  auto sensor = DistanceSensor::Create();
+  if (!sensor) {
+    fprintf(stderr, "VL53L1X not found on the emulated bus\n");
+    g_failures++;
+    return;
+  }
+  // The reset, the boot status, then one transaction to read the
+  // configuration block and one to write it back as a whole.
+  EXPECT_EQ(5u, TakeBusStats().transactions);
+  EXPECT_EQ(0x0b, registers[VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A]);
+  EXPECT_EQ(0x8b, registers[VL53L1_SYSTEM__SEQUENCE_CONFIG]);
+  EXPECT_EQ(0x0a, registers[VL53L1_DSS_CONFIG__TARGET_TOTAL_RATE_MCPS]);
+  // The shadow knows the block, so setting the same range sends nothing.
+  sensor->SetRange(DistanceSensor::Range::kMedium);
+  EXPECT_EQ(0u, TakeBusStats().transactions);
+  sensor->SetRange(DistanceSensor::Range::kLong);
+  EXPECT_EQ(1u, TakeBusStats().transactions);
+  EXPECT_EQ(0x0f, registers[VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A]);
+  sensor->SetRange(DistanceSensor::Range::kMedium);
+  sensor->Start(100);
+  EXPECT_EQ(0x01, registers[VL53L1_SYSTEM__INTERRUPT_CLEAR]);
+  EXPECT_EQ(0x40, registers[VL53L1_SYSTEM__MODE_START]);
+  EXPECT_EQ(100u * 0x0300,
+            static_cast<uint32_t>(
+                (registers[VL53L1_SYSTEM__INTERMEASUREMENT_PERIOD] << 24) |
+                (registers[VL53L1_SYSTEM__INTERMEASUREMENT_PERIOD + 1] << 16) |
+                (registers[VL53L1_SYSTEM__INTERMEASUREMENT_PERIOD + 2] << 8) |
+                registers[VL53L1_SYSTEM__INTERMEASUREMENT_PERIOD + 3]));
+
+  // Not ready: the interrupt line is active low.
+  registers[VL53L1_GPIO__TIO_HV_STATUS] = 0x01;
+  TakeBusStats();
+  uint32_t distance_mm = 0;
+  EXPECT_EQ(false, sensor->GetDistanceMM(distance_mm));
+  TakeBusStats();
+  auto heap = GetHeapStats();
+  EXPECT_EQ(false, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ(heap.allocations, GetHeapStats().allocations);
+  auto stats = TakeBusStats();
+  EXPECT_EQ(1u, stats.transactions);
+  EXPECT_EQ(2u, stats.starts);
+
+  registers[VL53L1_GPIO__TIO_HV_STATUS] = 0x00;
+  registers[VL53L1_RESULT__RANGE_STATUS] = 9;
+  registers[VL53L1_RESULT__STREAM_COUNT] = 1;
+  SetRegister16(VL53L1_RESULT__FINAL_CROSSTALK_CORRECTED_RANGE_MM_SD0, 1000);
+  // The first measurement also sets up the calibration. No SPADs reported,
+  // so the target goes to the mid point.
+  EXPECT_EQ(true, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ(0x80,
+            registers[VL53L1_DSS_CONFIG__MANUAL_EFFECTIVE_SPADS_SELECT]);
+  registers[VL53L1_SYSTEM__INTERRUPT_CLEAR] = 0;
+  TakeBusStats();
+  // The target hasn't changed, so only the interrupt is cleared.
+  EXPECT_EQ(true, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ((1000u * 2011 + 0x400) / 0x800, distance_mm);
+  EXPECT_EQ(0x01, registers[VL53L1_SYSTEM__INTERRUPT_CLEAR]);
+  stats = TakeBusStats();
+  EXPECT_EQ(3u, stats.transactions);
+  EXPECT_EQ(5u, stats.starts);
+
+  // A new target goes out with the interrupt clear. Now that both have been
+  // submitted once, neither touches the heap.
+  SetRegister16(VL53L1_RESULT__DSS_ACTUAL_EFFECTIVE_SPADS_SD0, 1 << 8);
+  SetRegister16(VL53L1_RESULT__AMBIENT_COUNT_RATE_MCPS_SD0, kTargetRate);
+  heap = GetHeapStats();
+  EXPECT_EQ(true, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ(0x01,
+            registers[VL53L1_DSS_CONFIG__MANUAL_EFFECTIVE_SPADS_SELECT]);
+  EXPECT_EQ(0x00,
+            registers[VL53L1_DSS_CONFIG__MANUAL_EFFECTIVE_SPADS_SELECT + 1]);
+  stats = TakeBusStats();
+  EXPECT_EQ(3u, stats.transactions);
+  EXPECT_EQ(6u, stats.starts);
+  EXPECT_EQ(true, sensor->GetDistanceMM(distance_mm));
+  EXPECT_EQ(5u, TakeBusStats().starts);
+  auto heap_after = GetHeapStats();
+  EXPECT_EQ(heap.allocations, heap_after.allocations);
+  EXPECT_EQ(heap.frees, heap_after.frees);
+}
+
+}  // namespace
+
+int main() {
+  TestSingleAccesses();
+  TestBursts();
+  TestBatches();
+  TestResubmit();
+  TestShadow();
+  TestDistanceSensor();
+  return TestResult("I2C transactions OK");
+}
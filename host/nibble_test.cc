@@ -0,0 +1,128 @@
+// Checks the SWAR kernels in nibble.h against scalar per-pixel versions.
+
+#include "nibble.h"
+
+#include <random>
+#include <vector>
+
+#include "test_util.h"
+
+namespace {
+
+uint8_t Pixel(uint32_t word, size_t i) {
+  return (word >> (4 * i)) & 0xf;
+}
+
+uint32_t ScalarDecrement(uint32_t word) {
+  uint32_t result = 0;
+  for (size_t i = 0; i < 8; i++) {
+    uint8_t p = Pixel(word, i);
+    result |= static_cast<uint32_t>(p ? p - 1 : 0) << (4 * i);
+  }
+  return result;
+}
+
+uint32_t ScalarBlend(uint32_t dest, uint32_t src) {
+  uint32_t result = 0;
+  for (size_t i = 0; i < 8; i++) {
+    uint8_t p = Pixel(src, i) ? Pixel(src, i) : Pixel(dest, i);
+    result |= static_cast<uint32_t>(p) << (4 * i);
+  }
+  return result;
+}
+
+uint32_t ScalarDouble(uint32_t word) {
+  uint32_t result = 0;
+  for (size_t i = 0; i < 4; i++)
+    result |= static_cast<uint32_t>(Pixel(word, i) * 0x11) << (8 * i);
+  return result;
+}
+
+// Random words with plenty of zero pixels, which are the interesting case.
+std::vector<uint32_t> TestWords() {
+  std::vector<uint32_t> words = {0, ~0u, 0x11111111, 0x10101010, 0x0f0f0f0f,
+                                 0xf0f0f0f0, 0x80000001, 0x12345678};
+  std::mt19937 random(1234);
+  for (int i = 0; i < 100000; i++) {
+    uint32_t word = random();
+    word &= random() | random();
+    words.push_back(word);
+  }
+  return words;
+}
+
+void TestDecrement(const std::vector<uint32_t>& words) {
+  for (uint32_t word : words)
+    EXPECT_EQ(ScalarDecrement(word), DecrementNibbles(word));
+  // Every pixel reaches zero and stays there.
+  uint32_t word = 0xfedcba98;
+  for (int i = 0; i < 16; i++)
+    word = DecrementNibbles(word);
+  EXPECT_EQ(0u, word);
+}
+
+void TestBlend(const std::vector<uint32_t>& words) {
+  for (size_t i = 1; i < words.size(); i++) {
+    uint32_t dest = words[i - 1];
+    uint32_t src = words[i];
+    EXPECT_EQ(ScalarBlend(dest, src),
+              BlendNibbles(dest, src, OpaqueMask(src)));
+    EXPECT_EQ(src, BlendNibbles(dest, src, ~0u));
+    EXPECT_EQ(dest, BlendNibbles(dest, src, 0));
+  }
+}
+
+void TestDouble(const std::vector<uint32_t>& words) {
+  for (uint32_t word : words) {
+    EXPECT_EQ(ScalarDouble(word), DoubleNibbles(word));
+    EXPECT_EQ(ScalarDouble(word >> 16), DoubleNibbles(word >> 16));
+  }
+}
+
+void TestLoadStore() {
+  const uint8_t bytes[] = {0x01, 0x23, 0x45, 0x67, 0x89};
+  EXPECT_EQ(0x67452301u, LoadNibbles(bytes));
+  EXPECT_EQ(0x89674523u, LoadNibbles(bytes + 1));
+  EXPECT_EQ(0x00452301u, LoadNibbles(bytes, 3));
+  uint8_t out[5] = {0xaa, 0xaa, 0xaa, 0xaa, 0xaa};
+  StoreNibbles(out + 1, 0x44332211, 2);
+  EXPECT_EQ(0xaa, out[0]);
+  EXPECT_EQ(0x11, out[1]);
+  EXPECT_EQ(0x22, out[2]);
+  EXPECT_EQ(0xaa, out[3]);
+}
+
+void TestClearAndMove() {
+  uint32_t words[16];
+  for (uint32_t i = 0; i < 16; i++)
+    words[i] = i + 1;
+  ClearWords(words + 2, 3);
+  EXPECT_EQ(2u, words[1]);
+  EXPECT_EQ(0u, words[2]);
+  EXPECT_EQ(0u, words[4]);
+  EXPECT_EQ(6u, words[5]);
+
+  // Overlapping moves in both directions.
+  for (uint32_t i = 0; i < 16; i++)
+    words[i] = i;
+  MoveWords(words + 3, words, 10);
+  for (uint32_t i = 0; i < 10; i++)
+    EXPECT_EQ(i, words[i + 3]);
+  for (uint32_t i = 0; i < 16; i++)
+    words[i] = i;
+  MoveWords(words, words + 3, 10);
+  for (uint32_t i = 0; i < 10; i++)
+    EXPECT_EQ(i + 3, words[i]);
+}
+
+}  // namespace
+
+int main() {
+  auto words = TestWords();
+  TestDecrement(words);
+  TestBlend(words);
+  TestDouble(words);
+  TestLoadStore();
+  TestClearAndMove();
+  return TestResult("All nibble kernel tests passed");
+}
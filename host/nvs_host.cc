@@ -0,0 +1,113 @@
+#include "nvs_host.h"
+
+#include <string.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <nvs_flash.h>
+
+namespace {
+
+struct Handle {
+  std::string name;
+  bool writable;
+};
+
+NVSStats g_stats;
+// Blobs by namespace and key.
+std::map<std::string, std::map<std::string, std::vector<uint8_t>>> g_blobs;
+std::map<nvs_handle, Handle> g_handles;
+nvs_handle g_next_handle = 1;
+
+// The namespace of |handle|, or null if it isn't open.
+const Handle* Find(nvs_handle handle) {
+  auto it = g_handles.find(handle);
+  return it == g_handles.end() ? nullptr : &it->second;
+}
+
+}  // namespace
+
+const NVSStats& GetNVSStats() {
+  return g_stats;
+}
+
+void ResetNVS() {
+  g_blobs.clear();
+  g_stats = NVSStats();
+}
+
+esp_err_t nvs_flash_init() {
+  return ESP_OK;
+}
+
+esp_err_t nvs_flash_erase() {
+  g_blobs.clear();
+  return ESP_OK;
+}
+
+esp_err_t nvs_open(const char* name,
+                   nvs_open_mode open_mode,
+                   nvs_handle* out_handle) {
+  // Like the SDK, a namespace only exists once opened for writing.
+  if (open_mode == NVS_READONLY && !g_blobs.count(name))
+    return ESP_ERR_NVS_NOT_FOUND;
+  g_blobs[name];
+  *out_handle = g_next_handle++;
+  g_handles[*out_handle] = Handle{name, open_mode == NVS_READWRITE};
+  return ESP_OK;
+}
+
+void nvs_close(nvs_handle handle) {
+  g_handles.erase(handle);
+}
+
+esp_err_t nvs_get_blob(nvs_handle handle,
+                       const char* key,
+                       void* out_value,
+                       size_t* length) {
+  const Handle* open = Find(handle);
+  if (!open)
+    return ESP_ERR_NVS_INVALID_HANDLE;
+  const auto& blobs = g_blobs[open->name];
+  auto it = blobs.find(key);
+  if (it == blobs.end())
+    return ESP_ERR_NVS_NOT_FOUND;
+  const auto& blob = it->second;
+  // A null |out_value| asks for the length.
+  if (out_value) {
+    if (*length < blob.size())
+      return ESP_ERR_NVS_INVALID_LENGTH;
+    memcpy(out_value, blob.data(), blob.size());
+  }
+  *length = blob.size();
+  return ESP_OK;
+}
+
+esp_err_t nvs_set_blob(nvs_handle handle,
+                       const char* key,
+                       const void* value,
+                       size_t length) {
+  const Handle* open = Find(handle);
+  if (!open || !open->writable)
+    return ESP_ERR_NVS_INVALID_HANDLE;
+  const auto* bytes = static_cast<const uint8_t*>(value);
+  g_blobs[open->name][key].assign(bytes, bytes + length);
+  g_stats.writes++;
+  return ESP_OK;
+}
+
+esp_err_t nvs_erase_key(nvs_handle handle, const char* key) {
+  const Handle* open = Find(handle);
+  if (!open || !open->writable)
+    return ESP_ERR_NVS_INVALID_HANDLE;
+  if (!g_blobs[open->name].erase(key))
+    return ESP_ERR_NVS_NOT_FOUND;
+  g_stats.writes++;
+  return ESP_OK;
+}
+
+esp_err_t nvs_commit(nvs_handle handle) {
+  return Find(handle) ? ESP_OK : ESP_ERR_NVS_INVALID_HANDLE;
+}
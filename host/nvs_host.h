@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <nvs.h>
+
+// Host implementation of the SDK's NVS API: namespaces of blobs in memory,
+// which last until the process exits, like flash over reboots. Only blobs
+// are supported, and nvs_flash_init() needn't be called.
+struct NVSStats {
+  // Successful nvs_set_blob() and nvs_erase_key() calls, which would write
+  // flash.
+  uint32_t writes = 0;
+};
+
+const NVSStats& GetNVSStats();
+
+// Erases everything, like nvs_flash_erase(), and resets the stats.
+void ResetNVS();
@@ -0,0 +1,144 @@
+// Checks the measurement queue, alone and between two threads, and that the
+// sensor task delivers every measurement of a fake sensor to the render
+// side.
+
+#include "sensor_task.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "frame_scheduler.h"
+#include "spsc_queue.h"
+#include "test_util.h"
+
+namespace {
+
+void TestQueue() {
+  SPSCQueue<uint32_t, 4> queue;
+  uint32_t item = 0;
+  EXPECT_TRUE(!queue.Pop(item));
+  // Wraps around the ring a few times, filling it each time.
+  uint32_t pushed = 0;
+  uint32_t popped = 0;
+  for (int round = 0; round < 3; round++) {
+    while (queue.Push(pushed))
+      pushed++;
+    EXPECT_EQ(4u, queue.size());
+    while (queue.Pop(item))
+      EXPECT_EQ(popped++, item);
+    EXPECT_EQ(0u, queue.size());
+  }
+  EXPECT_EQ(12u, popped);
+}
+
+// Pushes a sequence from a second thread while this one pops it. Both yield
+// when they can't make progress, in case they share a core.
+void TestQueueThreads() {
+  constexpr uint32_t kItems = 100000;
+  using Queue = SPSCQueue<uint32_t, 8>;
+  Queue queue;
+  EXPECT_EQ(pdPASS, xTaskCreate(
+                        [](void* arg) {
+                          auto* queue = static_cast<Queue*>(arg);
+                          for (uint32_t i = 0; i < kItems; i++) {
+                            while (!queue->Push(i))
+                              std::this_thread::yield();
+                          }
+                          vTaskDelete(nullptr);
+                        },
+                        "producer", 1024, &queue, 1, nullptr));
+  uint32_t expected = 0;
+  uint32_t item;
+  while (expected < kItems) {
+    if (queue.Pop(item)) {
+      if (item != expected) {
+        EXPECT_EQ(expected, item);
+        break;
+      }
+      expected++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  EXPECT_EQ(kItems, expected);
+  EXPECT_TRUE(!queue.Pop(item));
+}
+
+// Has a new measurement every |period_ms| of wall time, counting up from 1.
+class FakeSensor : public DistanceSensor {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit FakeSensor(bool& stopped) : stopped_(stopped) {}
+
+  void Start(uint32_t period_ms) override {
+    period_ = std::chrono::milliseconds(period_ms);
+    next_ = Clock::now() + period_;
+  }
+  void Stop() override { stopped_ = true; }
+  bool GetDistanceMM(uint32_t& distance_mm) override {
+    if (Clock::now() < next_)
+      return false;
+    next_ += period_;
+    distance_mm = ++count_;
+    return true;
+  }
+  bool SaveCalibration() override { return false; }
+  void SetRange(Range) override {}
+
+ private:
+  bool& stopped_;
+  Clock::duration period_;
+  Clock::time_point next_;
+  uint32_t count_ = 0;
+};
+
+void TestSensorTask() {
+  constexpr uint32_t kPeriodMs = 30;
+  constexpr uint32_t kMeasurements = 10;
+  bool stopped = false;
+  SensorTask sensor_task(
+      std::unique_ptr<DistanceSensor>(new FakeSensor(stopped)), kPeriodMs);
+  EXPECT_TRUE(sensor_task.Start(xTaskGetCurrentTaskHandle(), 2, 1024));
+
+  // Like the render task: wait with a long timeout, which each measurement
+  // cuts short, and drain the queue.
+  FrameScheduler scheduler;
+  TickType_t start = xTaskGetTickCount();
+  TickType_t last_tick = start;
+  uint32_t received = 0;
+  int waits = 0;
+  while (received < kMeasurements && waits++ < 100) {
+    scheduler.Wait(1000 / portTICK_PERIOD_MS);
+    Measurement measurement;
+    while (sensor_task.queue().Pop(measurement)) {
+      EXPECT_EQ(++received, measurement.distance_mm);
+      EXPECT_TRUE(static_cast<int32_t>(measurement.tick - last_tick) >= 0);
+      last_tick = measurement.tick;
+    }
+  }
+  TickType_t elapsed = xTaskGetTickCount() - start;
+  EXPECT_EQ(kMeasurements, received);
+  // Waking up on the timeouts would have taken seconds.
+  EXPECT_TRUE(elapsed * portTICK_PERIOD_MS < 3 * kMeasurements * kPeriodMs);
+
+  sensor_task.Stop();
+  for (int i = 0; i < 100 && sensor_task.running(); i++)
+    vTaskDelay(1);
+  EXPECT_TRUE(!sensor_task.running());
+  EXPECT_TRUE(stopped);
+  auto stats = sensor_task.stats();
+  EXPECT_EQ(0u, stats.dropped);
+  EXPECT_TRUE(stats.measurements >= kMeasurements);
+  EXPECT_TRUE(stats.polls >= stats.measurements);
+}
+
+}  // namespace
+
+int main() {
+  TestQueue();
+  TestQueueThreads();
+  TestSensorTask();
+  return TestResult("Sensor task and queue OK");
+}
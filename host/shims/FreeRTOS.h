@@ -0,0 +1,28 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <mutex>
+
+typedef uint32_t TickType_t;
+typedef int32_t BaseType_t;
+typedef uint32_t UBaseType_t;
+
+#define configTICK_RATE_HZ 100
+#define portTICK_PERIOD_MS (1000 / configTICK_RATE_HZ)
+#define portTICK_RATE_MS portTICK_PERIOD_MS
+#define portMAX_DELAY 0xffffffffu
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS pdTRUE
+#define pdFAIL pdFALSE
+
+// Critical sections keep the other tasks out, like on the single core
+// device. The host has no interrupts to mask.
+inline std::recursive_mutex& HostCriticalSection() {
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+#define portENTER_CRITICAL() HostCriticalSection().lock()
+#define portEXIT_CRITICAL() HostCriticalSection().unlock()
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "esp_attr.h"
+
+typedef enum {
+  GPIO_NUM_0 = 0,
+  GPIO_NUM_1,
+  GPIO_NUM_2,
+  GPIO_NUM_3,
+  GPIO_NUM_4,
+  GPIO_NUM_5,
+  GPIO_NUM_6,
+  GPIO_NUM_7,
+  GPIO_NUM_8,
+  GPIO_NUM_9,
+  GPIO_NUM_10,
+  GPIO_NUM_11,
+  GPIO_NUM_12,
+  GPIO_NUM_13,
+  GPIO_NUM_14,
+  GPIO_NUM_15,
+  GPIO_NUM_16,
+} gpio_num_t;
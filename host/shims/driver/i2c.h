@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "driver/gpio.h"
+#include "esp_err.h"
+#include "rom/ets_sys.h"
+
+// The master side of the SDK's I2C driver, implemented by i2c_host.cc.
+typedef enum {
+  I2C_NUM_0 = 0,
+  I2C_NUM_MAX,
+} i2c_port_t;
+
+typedef enum {
+  I2C_MASTER_WRITE = 0,
+  I2C_MASTER_READ,
+} i2c_rw_t;
+
+typedef enum {
+  I2C_MASTER_ACK = 0,
+  I2C_MASTER_NACK,
+  I2C_MASTER_LAST_NACK,
+} i2c_ack_type_t;
+
+typedef struct HostI2CCommands* i2c_cmd_handle_t;
+
+i2c_cmd_handle_t i2c_cmd_link_create();
+void i2c_cmd_link_delete(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_start(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_stop(i2c_cmd_handle_t cmd);
+esp_err_t i2c_master_write_byte(i2c_cmd_handle_t cmd,
+                                uint8_t data,
+                                bool ack_en);
+esp_err_t i2c_master_write(i2c_cmd_handle_t cmd,
+                           uint8_t* data,
+                           size_t data_len,
+                           bool ack_en);
+esp_err_t i2c_master_read_byte(i2c_cmd_handle_t cmd,
+                               uint8_t* data,
+                               i2c_ack_type_t ack);
+esp_err_t i2c_master_read(i2c_cmd_handle_t cmd,
+                          uint8_t* data,
+                          size_t data_len,
+                          i2c_ack_type_t ack);
+esp_err_t i2c_master_cmd_begin(i2c_port_t i2c_num,
+                               i2c_cmd_handle_t cmd,
+                               TickType_t ticks_to_wait);
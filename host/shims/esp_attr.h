@@ -0,0 +1,10 @@
+#pragma once
+
+// Host stand-ins for the ESP8266 SDK. Code and data placement attributes have
+// no meaning on the host.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define IRAM_ATTR
+#define DRAM_ATTR
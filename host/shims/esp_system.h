@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "esp_attr.h"
+
+inline uint32_t esp_get_free_heap_size() {
+  return 0;
+}
+
+inline void esp_restart() {
+  abort();
+}
+
+// newlib provides itoa() but glibc doesn't.
+inline char* itoa(int value, char* str, int base) {
+  char* p = str;
+  unsigned int v = value < 0 ? -value : value;
+  do {
+    int digit = v % base;
+    *p++ = digit < 10 ? '0' + digit : 'a' + digit - 10;
+    v /= base;
+  } while (v);
+  if (value < 0)
+    *p++ = '-';
+  *p = 0;
+  for (char *a = str, *b = p - 1; a < b; a++, b--) {
+    char t = *a;
+    *a = *b;
+    *b = t;
+  }
+  return str;
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <pthread.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "../FreeRTOS.h"
+
+#define tskIDLE_PRIORITY 0
+
+inline TickType_t xTaskGetTickCount() {
+  using Ticks =
+      std::chrono::duration<TickType_t, std::ratio<1, configTICK_RATE_HZ>>;
+  return std::chrono::duration_cast<Ticks>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+inline TickType_t xPortGetTickRateHz() {
+  return configTICK_RATE_HZ;
+}
+
+inline void vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(
+      std::chrono::milliseconds(ticks * portTICK_PERIOD_MS));
+}
+
+// Tasks are pthreads. Priorities and stack depths are ignored: the host
+// schedules the threads on as many cores as it has, and its code needs
+// bigger stacks than the device's.
+typedef void (*TaskFunction_t)(void*);
+
+struct HostTask {
+  std::mutex mutex;
+  std::condition_variable notified;
+  uint32_t notifications = 0;
+  TaskFunction_t function = nullptr;
+  void* arg = nullptr;
+};
+typedef HostTask* TaskHandle_t;
+
+inline HostTask*& CurrentHostTask() {
+  thread_local HostTask* task = nullptr;
+  return task;
+}
+
+// Threads not started by xTaskCreate(), like main(), get a task on first
+// use. Like the tasks themselves, it is never freed, so that a late
+// notification can't touch freed memory.
+inline TaskHandle_t xTaskGetCurrentTaskHandle() {
+  HostTask*& task = CurrentHostTask();
+  if (!task)
+    task = new HostTask();
+  return task;
+}
+
+inline BaseType_t xTaskCreate(TaskFunction_t function,
+                              const char* name,
+                              uint32_t /* stack_depth */,
+                              void* arg,
+                              UBaseType_t /* priority */,
+                              TaskHandle_t* handle) {
+  auto* task = new HostTask();
+  task->function = function;
+  task->arg = arg;
+  auto run = [](void* arg) -> void* {
+    auto* task = static_cast<HostTask*>(arg);
+    CurrentHostTask() = task;
+    task->function(task->arg);
+    return nullptr;
+  };
+  pthread_attr_t attributes;
+  pthread_attr_init(&attributes);
+  pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+  pthread_t thread;
+  int error = pthread_create(&thread, &attributes, run, task);
+  pthread_attr_destroy(&attributes);
+  if (error) {
+    delete task;
+    return pdFAIL;
+  }
+  pthread_setname_np(thread, name);
+  if (handle)
+    *handle = task;
+  return pdPASS;
+}
+
+// Only a task deleting itself, right before its function returns, which ends
+// the thread.
+inline void vTaskDelete(TaskHandle_t /* task */) {}
+
+// The host doesn't track the tasks' stacks.
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t /* task */) {
+  return 0;
+}
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  {
+    std::lock_guard<std::mutex> lock(task->mutex);
+    task->notifications++;
+  }
+  task->notified.notify_one();
+  return pdPASS;
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+  HostTask* task = xTaskGetCurrentTaskHandle();
+  std::unique_lock<std::mutex> lock(task->mutex);
+  auto pending = [task] { return task->notifications != 0; };
+  if (ticks == portMAX_DELAY) {
+    task->notified.wait(lock, pending);
+  } else {
+    task->notified.wait_for(
+        lock, std::chrono::milliseconds(ticks * portTICK_PERIOD_MS), pending);
+  }
+  uint32_t count = task->notifications;
+  if (count)
+    task->notifications = clear ? 0 : count - 1;
+  return count;
+}
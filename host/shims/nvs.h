@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+// The SDK's NVS API, implemented by nvs_host.cc over memory.
+#define ESP_ERR_NVS_BASE 0x1100
+#define ESP_ERR_NVS_NOT_INITIALIZED (ESP_ERR_NVS_BASE + 0x01)
+#define ESP_ERR_NVS_NOT_FOUND (ESP_ERR_NVS_BASE + 0x02)
+#define ESP_ERR_NVS_INVALID_HANDLE (ESP_ERR_NVS_BASE + 0x07)
+#define ESP_ERR_NVS_INVALID_LENGTH (ESP_ERR_NVS_BASE + 0x0c)
+#define ESP_ERR_NVS_NO_FREE_PAGES (ESP_ERR_NVS_BASE + 0x0d)
+
+typedef uint32_t nvs_handle;
+
+typedef enum {
+  NVS_READONLY,
+  NVS_READWRITE,
+} nvs_open_mode;
+
+esp_err_t nvs_open(const char* name,
+                   nvs_open_mode open_mode,
+                   nvs_handle* out_handle);
+void nvs_close(nvs_handle handle);
+esp_err_t nvs_get_blob(nvs_handle handle,
+                       const char* key,
+                       void* out_value,
+                       size_t* length);
+esp_err_t nvs_set_blob(nvs_handle handle,
+                       const char* key,
+                       const void* value,
+                       size_t length);
+esp_err_t nvs_erase_key(nvs_handle handle, const char* key);
+esp_err_t nvs_commit(nvs_handle handle);
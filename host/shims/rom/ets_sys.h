@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <chrono>
+#include <thread>
+
+inline void os_delay_us(uint32_t us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// Checks for the host tests. A failed check prints where it failed and is
+// counted in |g_failures|, and the test goes on.
+inline int g_failures = 0;
+
+#define EXPECT_TRUE(condition)                                    \
+  do {                                                            \
+    if (!(condition)) {                                           \
+      fprintf(stderr, "%s:%d: expected %s\n", __FILE__, __LINE__, \
+              #condition);                                        \
+      g_failures++;                                               \
+    }                                                             \
+  } while (0)
+
+#define EXPECT_EQ(expected, actual)                                        \
+  do {                                                                     \
+    auto e = (expected);                                                   \
+    auto a = (actual);                                                     \
+    if (e != a) {                                                          \
+      fprintf(stderr, "%s:%d: %s: expected 0x%x, got 0x%x\n", __FILE__,    \
+              __LINE__, #actual, static_cast<unsigned>(e),                 \
+              static_cast<unsigned>(a));                                   \
+      g_failures++;                                                        \
+    }                                                                      \
+  } while (0)
+
+// Prints the number of failures, or |message| if there were none, and
+// returns the exit status for main().
+inline int TestResult(const char* message) {
+  if (g_failures) {
+    fprintf(stderr, "%d failures\n", g_failures);
+    return EXIT_FAILURE;
+  }
+  printf("%s\n", message);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,82 @@
+#include "asset_cache.h"
+
+#include <assert.h>
+#include <esp_attr.h>
+
+const uint8_t* IRAM_ATTR AssetCache::Get(const uint32_t* source,
+                                         size_t bytes) {
+  size_t size = (bytes + 3) / 4;
+  for (size_t i = 0; i < entry_count_; i++) {
+    auto& entry = entries_[i];
+    if (entry.source == source && entry.size >= size) {
+      entry.last_used = frame_;
+      stats_.hits++;
+      return reinterpret_cast<const uint8_t*>(&pool_[entry.offset]);
+    }
+  }
+
+  stats_.misses++;
+  stats_.miss_bytes += size * 4;
+  assert(size <= pool_.size());
+  int index = -1;
+  while (entry_count_ == entries_.size() || (index = FindSpace(size)) < 0)
+    Evict();
+  uint16_t offset = 0;
+  if (index)
+    offset = entries_[index - 1].offset + entries_[index - 1].size;
+  // Flash only supports word reads.
+  for (size_t i = 0; i < size; i++)
+    pool_[offset + i] = source[i];
+  for (size_t i = entry_count_; i > static_cast<size_t>(index); i--)
+    entries_[i] = entries_[i - 1];
+  entries_[index] = Entry{source, offset, static_cast<uint16_t>(size), frame_};
+  entry_count_++;
+  return reinterpret_cast<const uint8_t*>(&pool_[offset]);
+}
+
+void IRAM_ATTR AssetCache::NextFrame() {
+  frame_++;
+  if (fragmented_)
+    Compact();
+}
+
+int AssetCache::FindSpace(size_t size) const {
+  // First fit.
+  size_t end = 0;
+  for (size_t i = 0; i < entry_count_; i++) {
+    if (entries_[i].offset - end >= size)
+      return i;
+    end = entries_[i].offset + entries_[i].size;
+  }
+  return pool_.size() - end >= size ? entry_count_ : -1;
+}
+
+void AssetCache::Evict() {
+  // Least recently used.
+  size_t victim = 0;
+  for (size_t i = 1; i < entry_count_; i++) {
+    if (entries_[i].last_used < entries_[victim].last_used)
+      victim = i;
+  }
+  if (entries_[victim].last_used == frame_)
+    stats_.overflows++;
+  entry_count_--;
+  for (size_t i = victim; i < entry_count_; i++)
+    entries_[i] = entries_[i + 1];
+  fragmented_ = true;
+}
+
+void AssetCache::Compact() {
+  // Between frames nothing refers to the copies, so they can move.
+  fragmented_ = false;
+  uint16_t end = 0;
+  for (size_t i = 0; i < entry_count_; i++) {
+    auto& entry = entries_[i];
+    if (entry.offset != end) {
+      for (size_t j = 0; j < entry.size; j++)
+        pool_[end + j] = pool_[entry.offset + j];
+      entry.offset = end;
+    }
+    end += entry.size;
+  }
+}
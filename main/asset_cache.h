@@ -0,0 +1,56 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+
+// RAM copies of the sprite and glyph data, which stays in flash. Flash can
+// only be read a word at a time and is slow on a cache miss, so the draw
+// paths read the assets of the current frame from here instead.
+class AssetCache {
+ public:
+  static constexpr size_t kBytes = 4096;
+  static constexpr size_t kMaxEntries = 24;
+
+  struct Stats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;
+    uint32_t miss_bytes = 0;
+    // Entries evicted while still in use by the current frame, because its
+    // assets didn't fit.
+    uint32_t overflows = 0;
+  };
+
+  // Returns a RAM copy of |bytes| bytes of the word aligned |source|. The
+  // copy stays valid until the end of the frame unless stats().overflows
+  // changes, in which case it is only valid until the next Get().
+  const uint8_t* Get(const uint32_t* source, size_t bytes);
+  // Ends the frame. Entries it didn't use may be evicted from now on.
+  void NextFrame();
+
+  const Stats& stats() const { return stats_; }
+  void ResetStats() { stats_ = Stats(); }
+
+ private:
+  struct Entry {
+    const uint32_t* source;
+    // In words.
+    uint16_t offset;
+    uint16_t size;
+    uint32_t last_used;
+  };
+
+  // Returns the index at which an entry of |size| words can be inserted,
+  // keeping |entries_| in pool order, or -1.
+  int FindSpace(size_t size) const;
+  void Evict();
+  void Compact();
+
+  std::array<uint32_t, kBytes / 4> pool_;
+  std::array<Entry, kMaxEntries> entries_;
+  uint8_t entry_count_ = 0;
+  uint32_t frame_ = 1;
+  bool fragmented_ = false;
+  Stats stats_;
+};
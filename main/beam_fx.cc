@@ -0,0 +1,191 @@
+#include "beam_fx.h"
+
+#include <esp_system.h>
+
+#include "font.h"
+#include "sprites.h"
+#include "util.h"
+
+constexpr Display::Rect BeamFX::kScanRect;
+
+BeamFX::BeamFX() {
+  SetPalette(kPalette);
+  CommitPalette();
+}
+
+void IRAM_ATTR BeamFX::Clear() {
+  item_count_ = 0;
+}
+
+void IRAM_ATTR BeamFX::FadePalette(uint8_t amount, uint32_t target_rgb) {
+  uint32_t target = ExplodeRGB565(PackRGB565(target_rgb));
+  for (size_t i = 0; i < pending_palette_.size(); i++)
+    pending_palette_[i] = LerpExplodedRGB565(base_palette_[i], target, amount);
+  palette_changed_ = true;
+}
+
+void IRAM_ATTR BeamFX::SetPalette(const std::array<uint32_t, 16>& palette) {
+  base_palette_ = palette;
+  pending_palette_ = palette;
+  palette_changed_ = true;
+}
+
+void IRAM_ATTR BeamFX::CommitPalette() {
+  palette_changed_ = false;
+  for (size_t i = 0; i < pair_sums_.size(); i++)
+    pair_sums_[i] = pending_palette_[i & 0x0f] + pending_palette_[i >> 4];
+}
+
+void IRAM_ATTR BeamFX::MeasureText(const char* text,
+                                   uint16_t& w,
+                                   uint16_t& h) {
+  w = 0;
+  h = 0;
+  while (*text) {
+    const auto& g = kGlyphs[*text - kFirstGlyph];
+    w += g.width;
+    h = std::max(h, static_cast<uint16_t>(g.height));
+    text++;
+  }
+}
+
+void IRAM_ATTR BeamFX::DrawText(const char* text, int x, int y) {
+  // Like RainbowFX's text layer, every glyph starts at an even column.
+  for (; *text >= kFirstGlyph && *text <= kLastGlyph; text++) {
+    const auto& g = kGlyphs[*text - kFirstGlyph];
+    int glyph_x = x & ~1;
+    x += g.width;
+    if (glyph_x + g.width > kWidth)
+      break;
+    Item* item = AddItem(ItemType::kGlyph, std::max(y, 0),
+                         std::min<int>(y + g.height, kHeight));
+    if (!item)
+      break;
+    item->source = &kGlyphSpanData[g.span_offset / 4];
+    item->bytes = g.span_size;
+    item->skip_rows = y < 0 ? -y : 0;
+    item->x = glyph_x / 2;
+    item->scale2x = false;
+  }
+}
+
+BeamFX::Item* IRAM_ATTR BeamFX::AddItem(ItemType type,
+                                        int first_line,
+                                        int last_line) {
+  if (first_line >= last_line)
+    return nullptr;
+  if (item_count_ == kMaxItems) {
+    dropped_items_++;
+    return nullptr;
+  }
+  Item& item = items_[item_count_++];
+  item.type = type;
+  item.first_line = first_line;
+  item.last_line = last_line;
+  return &item;
+}
+
+void IRAM_ATTR BeamFX::BeginRender() {
+  if (palette_changed_)
+    CommitPalette();
+  asset_cache_.NextFrame();
+  // Stable, so that items starting on the same line keep their order.
+  for (size_t i = 0; i < item_count_; i++) {
+    size_t j = i;
+    for (; j > 0 && items_[order_[j - 1]].first_line > items_[i].first_line;
+         j--) {
+      order_[j] = order_[j - 1];
+    }
+    order_[j] = i;
+  }
+  next_item_ = 0;
+  active_items_ = 0;
+  scan_row_ = 0;
+  render_column_ = 0;
+}
+
+void IRAM_ATTR BeamFX::Activate(Item& item) {
+  uint32_t overflows = asset_cache_.stats().overflows;
+  item.data = asset_cache_.Get(item.source, item.bytes);
+  const uint8_t* row = item.data;
+  for (size_t i = 0; i < item.skip_rows; i++) {
+    switch (item.type) {
+      case ItemType::kSpriteBits:
+        row += item.stride;
+        break;
+      case ItemType::kSpriteSpans:
+        row = RainbowFX::SkipSpanRow(row);
+        break;
+      case ItemType::kGlyph:
+        row += 1 + 2 * row[0];
+        break;
+    }
+  }
+  item.cursor = row - item.data;
+  if (asset_cache_.stats().overflows == overflows)
+    return;
+  // The copies of the other active items may have been evicted. This works
+  // as long as the assets of the items on one row fit in the cache.
+  for (uint32_t active = active_items_; active; active &= active - 1) {
+    Item& other = items_[__builtin_ctz(active)];
+    other.data = asset_cache_.Get(other.source, other.bytes);
+  }
+}
+
+void IRAM_ATTR BeamFX::DrawItemLine(Item& item, uint8_t* dest) {
+  dest += item.x;
+  const uint8_t* src = item.data + item.cursor;
+  switch (item.type) {
+    case ItemType::kSpriteBits:
+      if (item.blend && item.scale2x) {
+        RainbowFX::DrawSpriteRow<true, true>(dest, src, item.width);
+      } else if (item.blend) {
+        RainbowFX::DrawSpriteRow<true, false>(dest, src, item.width);
+      } else if (item.scale2x) {
+        RainbowFX::DrawSpriteRow<false, true>(dest, src, item.width);
+      } else {
+        RainbowFX::DrawSpriteRow<false, false>(dest, src, item.width);
+      }
+      src += item.stride;
+      break;
+    case ItemType::kSpriteSpans:
+      if (item.scale2x) {
+        src = RainbowFX::DrawSpanRow<true>(dest, src, item.width);
+      } else {
+        src = RainbowFX::DrawSpanRow<false>(dest, src, item.width);
+      }
+      break;
+    case ItemType::kGlyph:
+      for (uint8_t count = *src++; count; count--, src += 2)
+        RainbowFX::FillSpan(dest, src[0], src[0] + src[1]);
+      break;
+  }
+  item.cursor = src - item.data;
+}
+
+void IRAM_ATTR BeamFX::ComposeRow(size_t row) {
+  size_t line = 2 * row;
+  ClearWords(reinterpret_cast<uint32_t*>(lines_.data()), lines_.size() / 4);
+  while (next_item_ < item_count_ &&
+         items_[order_[next_item_]].first_line < line + 2) {
+    size_t index = order_[next_item_++];
+    Activate(items_[index]);
+    active_items_ |= 1u << index;
+  }
+  // In the order they were drawn.
+  for (uint32_t active = active_items_; active; active &= active - 1) {
+    size_t index = __builtin_ctz(active);
+    Item& item = items_[index];
+    if (item.scale2x) {
+      // Draws both lines from one row, and starts on an even line.
+      DrawItemLine(item, lines_.data());
+    } else {
+      for (size_t i = 0; i < 2; i++) {
+        if (line + i >= item.first_line && line + i < item.last_line)
+          DrawItemLine(item, &lines_[i * kLineBytes]);
+      }
+    }
+    if (item.last_line <= line + 2)
+      active_items_ &= ~(1u << index);
+  }
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <array>
+
+#include "asset_cache.h"
+#include "display.h"
+#include "rainbow_fx.h"
+#include "sprites.h"
+
+// Renders the same frames as RainbowFX without its backbuffer, racing the
+// beam: the drawing calls only record a display list, and each display row is
+// composed from it into a two line buffer when the scan-out reaches it, then
+// resolved like RainbowFX's supersampled backbuffer.
+//
+// This trades the 12 KB backbuffer and the Clear() and draw passes for
+// composing every row at scan-out. The row has to be ready before the batch
+// is due at the panel, and there is no damage tracking; every scan-out covers
+// the whole screen.
+class BeamFX {
+ public:
+  static constexpr auto kWidth = RainbowFX::kWidth;
+  static constexpr auto kHeight = RainbowFX::kHeight;
+  static constexpr size_t kMaxItems = 16;
+
+  using DefaultDrawTraits = RainbowFX::DefaultDrawTraits;
+  using BlendDrawTraits = RainbowFX::BlendDrawTraits;
+  using BlendDrawTraits1X = RainbowFX::BlendDrawTraits1X;
+  using SpanDrawTraits = RainbowFX::SpanDrawTraits;
+  using SpanDrawTraits1X = RainbowFX::SpanDrawTraits1X;
+
+  BeamFX();
+
+  // Prepares the scan-out of the whole screen from the display list.
+  void BeginRender();
+  // Resolves the next |count| pixels of the scan-out into |pixels|, in the
+  // format of |kColorMode|. Composes the next display row first if the
+  // scan-out is at the start of one.
+  template <Display::ColorMode kColorMode = Display::kColorMode>
+  void Render(uint32_t* pixels, size_t count);
+
+  const Display::Rect* scan_rects() const { return &kScanRect; }
+  size_t scan_rect_count() const { return 1; }
+
+  // Empties the display list.
+  void Clear();
+
+  // Like RainbowFX, these take effect at the next BeginRender().
+  void FadePalette(uint8_t amount, uint32_t target_rgb = 0);
+  void SetPalette(const std::array<uint32_t, 16>& palette);
+
+  // These add to the display list, in the same coordinates as RainbowFX and
+  // drawn in the same order.
+  void MeasureText(const char* text, uint16_t& w, uint16_t& h);
+  void DrawText(const char* text, int x, int y);
+  template <typename DrawTraits = DefaultDrawTraits>
+  void DrawSprite(const Sprite& sprite, int x, int y);
+
+  // Drawing calls that didn't fit in the display list and were left out.
+  uint32_t dropped_items() const { return dropped_items_; }
+  const AssetCache::Stats& asset_cache_stats() const {
+    return asset_cache_.stats();
+  }
+
+ private:
+  static constexpr Display::Rect kScanRect = {0, 0, Display::kWidth,
+                                              Display::kHeight};
+  static constexpr size_t kLineBytes = kWidth / 2;
+
+  enum class ItemType : uint8_t {
+    // Rows of kSpriteData.
+    kSpriteBits,
+    // Rows of kSpriteSpanData.
+    kSpriteSpans,
+    // Rows of kGlyphSpanData.
+    kGlyph,
+  };
+
+  // A sprite or glyph, clipped to the screen. The asset is copied to RAM when
+  // the scan-out reaches its first line.
+  struct Item {
+    const uint32_t* source;
+    const uint8_t* data;
+    uint16_t bytes;
+    // Offset into |data| of the next row to draw.
+    uint16_t cursor;
+    // Backbuffer lines [first_line, last_line) that the item covers.
+    uint8_t first_line;
+    uint8_t last_line;
+    // Rows of the asset above the screen.
+    uint8_t skip_rows;
+    // Offset of the left edge in the line, and the visible width, in bytes
+    // of sprite pixels.
+    uint8_t x;
+    uint8_t width;
+    // Bytes per row of kSpriteData.
+    uint8_t stride;
+    ItemType type;
+    bool blend;
+    bool scale2x;
+  };
+
+  Item* AddItem(ItemType type, int first_line, int last_line);
+  void Activate(Item& item);
+  void ComposeRow(size_t row);
+  void DrawItemLine(Item& item, uint8_t* dest);
+  void CommitPalette();
+
+  std::array<Item, kMaxItems> items_;
+  uint8_t item_count_ = 0;
+  uint32_t dropped_items_ = 0;
+
+  // Indices of |items_| sorted by first line, the next one to activate, and
+  // the items whose lines the scan-out is in, by bit.
+  std::array<uint8_t, kMaxItems> order_;
+  uint8_t next_item_ = 0;
+  uint32_t active_items_ = 0;
+  static_assert(kMaxItems <= 32, "Active item mask too small");
+
+  // The two backbuffer lines of the display row being scanned out.
+  std::array<uint8_t, 2 * kLineBytes> lines_ __attribute__((aligned));
+
+  std::array<uint32_t, 256> pair_sums_;
+  std::array<uint32_t, 16> pending_palette_;
+  bool palette_changed_ = false;
+  // The palette set by SetPalette(), which FadePalette() fades from.
+  std::array<uint32_t, 16> base_palette_;
+
+  AssetCache asset_cache_;
+  uint8_t scan_row_ = 0;
+  uint8_t render_column_ = 0;
+};
+
+template <typename DrawTraits>
+void IRAM_ATTR BeamFX::DrawSprite(const Sprite& sprite, int pos_x, int pos_y) {
+  // Clipped like RainbowFX::DrawSprite().
+  int width = sprite.width;
+  int height = sprite.height;
+  int skip_rows = 0;
+  if (pos_y < 0) {
+    skip_rows = -pos_y;
+    height -= skip_rows;
+    pos_y = 0;
+  }
+  int scale = DrawTraits::kScale2x ? 2 : 1;
+  if (pos_y + height > kHeight / scale)
+    height = kHeight / scale - pos_y;
+  int max_width = (kWidth - (pos_x & ~1)) / scale & ~1;
+  if (width > max_width)
+    width = max_width;
+  if (height <= 0 || width <= 0)
+    return;
+
+  auto type =
+      DrawTraits::kSpans ? ItemType::kSpriteSpans : ItemType::kSpriteBits;
+  Item* item = AddItem(type, scale * pos_y, scale * (pos_y + height));
+  if (!item)
+    return;
+  if (DrawTraits::kSpans) {
+    item->source = &kSpriteSpanData[sprite.span_offset / 4];
+    item->bytes = sprite.span_size;
+  } else {
+    item->source = &kSpriteData[sprite.offset / 4];
+    item->bytes = sprite.width / 2 * sprite.height;
+  }
+  item->skip_rows = skip_rows;
+  item->x = pos_x / 2;
+  item->width = width / 2;
+  item->stride = sprite.width / 2;
+  item->blend = DrawTraits::kBlend;
+  item->scale2x = DrawTraits::kScale2x;
+}
+
+template <Display::ColorMode kColorMode>
+__attribute__((always_inline)) inline void BeamFX::Render(uint32_t* pixels,
+                                                          size_t count) {
+  using PixelPair =
+      typename std::conditional<kColorMode == Display::COLOR_MODE_256,
+                                uint16_t, uint32_t>::type;
+  PixelPair* pairs = reinterpret_cast<PixelPair*>(pixels);
+  while (count) {
+    if (render_column_ == 0)
+      ComposeRow(scan_row_);
+    size_t span = std::min<size_t>(count, Display::kWidth - render_column_);
+    // Like RainbowFX's pair sum resolve.
+    const uint8_t* top = &lines_[render_column_];
+    const uint8_t* bottom = top + kLineBytes;
+    for (size_t i = 0; i < span / 2; i++, top += 2, bottom += 2) {
+      uint32_t s0 = pair_sums_[top[0]] + pair_sums_[bottom[0]];
+      uint32_t s1 = pair_sums_[top[1]] + pair_sums_[bottom[1]];
+      if (kColorMode == Display::COLOR_MODE_256) {
+        *pairs++ = UnexplodeRGB332(s0 >> 2) | (UnexplodeRGB332(s1 >> 2) << 8);
+      } else {
+        *pairs++ = __builtin_bswap16(UnexplodeRGB565(s0 >> 2)) |
+                   (__builtin_bswap16(UnexplodeRGB565(s1 >> 2)) << 16);
+      }
+    }
+    count -= span;
+    render_column_ += span;
+    if (render_column_ == Display::kWidth) {
+      render_column_ = 0;
+      scan_row_++;
+    }
+  }
+}
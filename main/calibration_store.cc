@@ -0,0 +1,69 @@
+#include "calibration_store.h"
+
+#include <assert.h>
+#include <nvs.h>
+#include <nvs_flash.h>
+#include <string.h>
+
+namespace {
+
+constexpr char kNamespace[] = "calibration";
+
+// The blob layout: the tag, then the data.
+struct Blob {
+  uint32_t tag;
+  uint8_t data[kMaxCalibrationSize];
+};
+
+}  // namespace
+
+bool SetupCalibrationStore() {
+  esp_err_t err = nvs_flash_init();
+  if (err == ESP_ERR_NVS_NO_FREE_PAGES) {
+    nvs_flash_erase();
+    err = nvs_flash_init();
+  }
+  return err == ESP_OK;
+}
+
+bool LoadCalibration(const char* key, uint32_t tag, void* data, size_t size) {
+  assert(size <= kMaxCalibrationSize);
+  nvs_handle handle;
+  if (nvs_open(kNamespace, NVS_READONLY, &handle) != ESP_OK)
+    return false;
+  Blob blob;
+  size_t length = sizeof(blob);
+  bool loaded = nvs_get_blob(handle, key, &blob, &length) == ESP_OK &&
+                length == sizeof(blob.tag) + size && blob.tag == tag;
+  nvs_close(handle);
+  if (loaded)
+    memcpy(data, blob.data, size);
+  return loaded;
+}
+
+bool StoreCalibration(const char* key,
+                      uint32_t tag,
+                      const void* data,
+                      size_t size) {
+  assert(size <= kMaxCalibrationSize);
+  nvs_handle handle;
+  if (nvs_open(kNamespace, NVS_READWRITE, &handle) != ESP_OK)
+    return false;
+  Blob blob;
+  blob.tag = tag;
+  memcpy(blob.data, data, size);
+  bool stored =
+      nvs_set_blob(handle, key, &blob, sizeof(blob.tag) + size) == ESP_OK &&
+      nvs_commit(handle) == ESP_OK;
+  nvs_close(handle);
+  return stored;
+}
+
+void EraseCalibration(const char* key) {
+  nvs_handle handle;
+  if (nvs_open(kNamespace, NVS_READWRITE, &handle) != ESP_OK)
+    return;
+  if (nvs_erase_key(handle, key) == ESP_OK)
+    nvs_commit(handle);
+  nvs_close(handle);
+}
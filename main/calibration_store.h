@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Calibration results kept in NVS across reboots, as small blobs under a key.
+// Each blob is stored with a tag naming its layout; one stored under another
+// tag, or of another size, doesn't load, so firmware that changes a layout
+// starts over with a fresh calibration.
+constexpr size_t kMaxCalibrationSize = 32;
+
+// Mounts the NVS partition, formatting it if it's full. Returns false if it
+// can't be used, and then nothing loads or is stored.
+bool SetupCalibrationStore();
+
+// Copies the blob under |key| into |data| and returns true if it's tagged
+// with |tag| and |size| bytes long.
+bool LoadCalibration(const char* key, uint32_t tag, void* data, size_t size);
+// Writes flash, which stalls the CPU for milliseconds.
+bool StoreCalibration(const char* key,
+                      uint32_t tag,
+                      const void* data,
+                      size_t size);
+void EraseCalibration(const char* key);
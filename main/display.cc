@@ -1,6 +1,8 @@
 #include "display.h"
 
 #include <FreeRTOS.h>
+#include <esp8266/gpio_struct.h>
+#include <esp8266/spi_struct.h>
 #include <freertos/task.h>
 
 #include "util.h"
@@ -14,9 +16,18 @@ SSD1331::SSD1331() {
       .intr_type = GPIO_INTR_DISABLE,
   };
   gpio_config(&kConfig);
+  SetSPITransferDoneHandler(&OnTransferDone, this);
+  // Every transfer is a plain MOSI write; see StartTransfer().
+  SPI1.user.usr_command = 0;
+  SPI1.user.usr_addr = 0;
+  SPI1.user.usr_dummy = 0;
+  SPI1.user.usr_miso = 0;
+  SPI1.user.usr_mosi = 1;
 
-  // Enable chip select.
+  // Enable chip select. The panel is the only device on the bus, so it stays
+  // selected.
   gpio_set_level(kPinCS, 0);
+  gpio_set_level(kPinDC, 0);
 
   // Reset.
   gpio_set_level(kPinRES, 1);
@@ -28,14 +39,7 @@ SSD1331::SSD1331() {
 
   WriteCommand(CMD_DISPLAYOFF);  // 0xAE
   WriteCommand(CMD_SETREMAP);    // 0xA0
-  uint8_t remap = 0x72;
-  if (kColorOrder == COLOR_ORDER_RGB)
-    remap |= 0xb100;
-  if (kFlipHorizontally)
-    remap &= ~0b10;
-  if (kFlipVertically)
-    remap &= ~0b10000;
-  WriteCommand(remap);
+  WriteCommand(Remap());
   WriteCommand(CMD_STARTLINE);  // 0xA1
   WriteCommand(0x0);
   WriteCommand(CMD_DISPLAYOFFSET);  // 0xA2
@@ -71,28 +75,25 @@ SSD1331::SSD1331() {
   WriteCommand(CMD_CONTRASTC);  // 0x83
   WriteCommand(0x7D);
   WriteCommand(CMD_DISPLAYON);  // Turn on the panel.
+  Flush();
 
   // Test pattern:
   // Fill(31, 63, 31);
 
   Clear();
-#if 0
-  if (!kRenderInBatches) {
-    for (size_t y = 0; y < kHeight; y++) {
-      for (size_t x = 0; x < kWidth; x++) {
-        uint16_t r = ((1 << 5) - 1) * (((x % 16) < 8) ? 1 : 0);
-        uint16_t g = ((1 << 6) - 1) * (((x % 32) < 16) ? 1 : 0);
-        uint16_t b = ((1 << 5) - 1) * (((y % 16) < 8) ? 1 : 0);
-        pixels_[(y * kWidth + x)] = r | (g << 5) | (b << 11);
-      }
-    }
-  }
+}
 
-  Benchmark([&] { Render([](uint32_t*) {}); });
-#endif
+void SSD1331::SetColorMode(ColorMode mode) {
+  color_mode_ = mode;
+  WriteCommand(CMD_SETREMAP);
+  WriteCommand(Remap());
+  Flush();
 }
 
-SSD1331::~SSD1331() = default;
+SSD1331::~SSD1331() {
+  Flush();
+  SetSPITransferDoneHandler(nullptr, nullptr);
+}
 
 void SSD1331::Clear() {
   WriteCommand(CMD_CLEAR);
@@ -100,6 +101,7 @@ void SSD1331::Clear() {
   WriteCommand(0);
   WriteCommand(kWidth - 1);
   WriteCommand(kHeight - 1);
+  Flush();
 }
 
 void SSD1331::Fill(uint8_t r, uint8_t g, uint8_t b) {
@@ -121,6 +123,49 @@ void SSD1331::Fill(uint8_t r, uint8_t g, uint8_t b) {
   WriteCommand(r);
   WriteCommand(g);
   WriteCommand(b);
+  Flush();
+}
+
+void IRAM_ATTR SSD1331::Execute(const DrawCommand* commands, size_t count) {
+  if (!count)
+    return;
+  WriteCommand(CMD_FILL);
+  WriteCommand(0x01);
+  for (size_t i = 0; i < count; i++) {
+    const DrawCommand& command = commands[i];
+    if (command.type == DrawCommand::kCopy) {
+      WriteCommand(CMD_COPY);
+      WriteCommand(command.rect.x0);
+      WriteCommand(command.rect.y0);
+      WriteCommand(command.rect.x1 - 1);
+      WriteCommand(command.rect.y1 - 1);
+      WriteCommand(command.x);
+      WriteCommand(command.y);
+    } else {
+      // In 256 color mode, fill with the color that the pixel data would
+      // have shown.
+      uint16_t color = command.color;
+      if (color_mode_ == COLOR_MODE_256)
+        color = ExpandRGB332(UnexplodeRGB332(ExplodeRGB565(color)));
+      // Colors are in a 6 bit range for each component.
+      uint8_t r = (color >> 11) << 1;
+      uint8_t g = (color >> 5) & 0x3f;
+      uint8_t b = (color & 0x1f) << 1;
+      WriteCommand(CMD_DRAWRECT);
+      WriteCommand(command.rect.x0);
+      WriteCommand(command.rect.y0);
+      WriteCommand(command.rect.x1 - 1);
+      WriteCommand(command.rect.y1 - 1);
+      WriteCommand(r);
+      WriteCommand(g);
+      WriteCommand(b);
+      WriteCommand(r);
+      WriteCommand(g);
+      WriteCommand(b);
+    }
+    Flush();
+    os_delay_us(kAccelerationDelayUs);
+  }
 }
 
 void SSD1331::Enable(bool enabled) {
@@ -133,24 +178,104 @@ void SSD1331::Enable(bool enabled) {
     WriteCommand(CMD_POWERMODE);
     WriteCommand(0x1A);
   }
+  Flush();
 }
 
 void IRAM_ATTR SSD1331::WriteCommand(uint16_t cmd) {
-  gpio_set_level(kPinDC, 0);
-  gpio_set_level(kPinCS, 0);
-  spi_trans_t trans;
-  memset(&trans, 0, sizeof(trans));
-  trans.cmd = &cmd;
-  trans.bits.cmd = 8;
-  spi_trans(HSPI_HOST, &trans);
+  // Commands are collected and sent in one transfer before the next data or
+  // Flush().
+  if (command_bytes_ == kChunkSizeBytes)
+    SendCommands();
+  reinterpret_cast<uint8_t*>(commands_.data())[command_bytes_++] = cmd;
+}
+
+void IRAM_ATTR SSD1331::SendCommands() {
+  if (!command_bytes_)
+    return;
+  WaitForIdle();
+  StartTransfer(commands_.data(), command_bytes_, false);
+  command_bytes_ = 0;
 }
 
 void IRAM_ATTR SSD1331::WriteData(const uint32_t* data, size_t bytes) {
-  gpio_set_level(kPinDC, 1);
-  gpio_set_level(kPinCS, 0);
-  spi_trans_t trans;
-  memset(&trans, 0, sizeof(trans));
-  trans.mosi = const_cast<uint32_t*>(data);
-  trans.bits.mosi = bytes * 8;
-  spi_trans(HSPI_HOST, &trans);
-}
\ No newline at end of file
+  SendCommands();
+  WaitForIdle();
+  StartTransfer(data, bytes, true);
+}
+
+void IRAM_ATTR SSD1331::StartTransfer(const uint32_t* data,
+                                      size_t bytes,
+                                      bool data_mode) {
+  // Called with the bus idle, which is when DC may change. This also runs
+  // from the transfer done interrupt (see OnTransferDone()), so it only
+  // touches the GPIO and SPI registers; spi_trans() and gpio_set_level()
+  // aren't safe to call there.
+  if (data_mode != data_mode_) {
+    if (data_mode)
+      GPIO.out_w1ts = 1 << kPinDC;
+    else
+      GPIO.out_w1tc = 1 << kPinDC;
+    data_mode_ = data_mode;
+  }
+  busy_ = true;
+  // The FIFO is sent starting with the low byte of the first word.
+  SPI1.user1.usr_mosi_bitlen = bytes * 8 - 1;
+  for (size_t i = 0; i < (bytes + 3) / 4; i++)
+    SPI1.data_buf[i] = data[i];
+  SPI1.cmd.usr = 1;
+}
+
+uint32_t* IRAM_ATTR SSD1331::AcquireChunk() {
+  if (submitted_chunks_ - completed_chunks_ == 2) {
+    scanout_stats_.render_stalls++;
+    while (submitted_chunks_ - completed_chunks_ == 2) {
+    }
+  }
+  return &pixels_[(submitted_chunks_ % 2) * kChunkWords];
+}
+
+void IRAM_ATTR SSD1331::SubmitChunk(size_t bytes, bool first) {
+  SendCommands();
+  scanout_stats_.chunks++;
+  chunk_bytes_[submitted_chunks_ % 2] = bytes;
+  portENTER_CRITICAL();
+  submitted_chunks_++;
+  if (!busy_) {
+    if (!first)
+      scanout_stats_.transfer_stalls++;
+    StartChunk();
+  }
+  portEXIT_CRITICAL();
+  if (!async_scanout_)
+    WaitForIdle();
+}
+
+void IRAM_ATTR SSD1331::Flush() {
+  SendCommands();
+  WaitForIdle();
+}
+
+void IRAM_ATTR SSD1331::WaitForIdle() {
+  while (busy_ || submitted_chunks_ != completed_chunks_) {
+  }
+}
+
+void IRAM_ATTR SSD1331::StartChunk() {
+  // Called with interrupts disabled or from the interrupt handler, with the
+  // bus idle.
+  size_t index = completed_chunks_ % 2;
+  chunk_active_ = true;
+  StartTransfer(&pixels_[index * kChunkWords], chunk_bytes_[index], true);
+}
+
+void IRAM_ATTR SSD1331::OnTransferDone(void* arg) {
+  auto* display = static_cast<SSD1331*>(arg);
+  display->busy_ = false;
+  if (display->chunk_active_) {
+    display->chunk_active_ = false;
+    display->completed_chunks_++;
+  }
+  // Keep the bus busy with the next chunk if it's ready.
+  if (display->submitted_chunks_ != display->completed_chunks_)
+    display->StartChunk();
+}
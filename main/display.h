@@ -3,6 +3,8 @@
 #include <esp_attr.h>
 #include <driver/gpio.h>
 #include <string.h>
+#include <algorithm>
+#include <array>
 #include <memory>
 
 #include "spi.h"
@@ -17,6 +19,8 @@ class SSD1331 {
   enum Command {
     CMD_DRAWLINE = 0x21,
     CMD_DRAWRECT = 0x22,
+    CMD_COPY = 0x23,
+    CMD_DIMWINDOW = 0x24,
     CMD_CLEAR = 0x25,
     CMD_FILL = 0x26,
     CMD_SETCOLUMN = 0x15,
@@ -51,6 +55,11 @@ class SSD1331 {
     COLOR_ORDER_BGR,
   };
 
+  // The graphic acceleration commands run asynchronously in the panel, and
+  // RAM writes issued before they finish are lost. The datasheet doesn't give
+  // a duration, so this is a conservative guess.
+  constexpr static uint32_t kAccelerationDelayUs = 200;
+
   constexpr static ColorOrder kColorOrder = COLOR_ORDER_RGB;
   constexpr static bool kFlipHorizontally = true;
   constexpr static bool kFlipVertically = true;
@@ -58,17 +67,72 @@ class SSD1331 {
  public:
   constexpr static uint8_t kWidth = 96;
   constexpr static uint8_t kHeight = 64;
-  constexpr static uint8_t kBitsPerPixel = 16;
+
+  // The panel takes RGB565 pixels in 65k color mode and RGB332 pixels in 256
+  // color mode, which halves the data per frame.
+  enum ColorMode {
+    COLOR_MODE_65K,
+    COLOR_MODE_256,
+  };
+  constexpr static ColorMode kColorMode = COLOR_MODE_65K;
+  constexpr static uint8_t BitsPerPixel(ColorMode mode) {
+    return mode == COLOR_MODE_256 ? 8 : 16;
+  }
+  constexpr static uint8_t kBitsPerPixel = kColorMode == COLOR_MODE_256 ? 8 : 16;
 
   // Whether to render in small batches to parallelize with the DMA update or
   // all at once.
   constexpr static bool kRenderInBatches = true;
 
-  // Number of pixels the renderer should produce per batch.
-  constexpr static auto kRenderBatchPixels =
+  // Whether batches are transferred from an interrupt while the next one is
+  // rendered, or one after the other.
+  constexpr static bool kAsyncScanout = true;
+
+  // Number of pixels the renderer should produce per batch in the default
+  // color mode.
+  constexpr static size_t kRenderBatchPixels =
       kRenderInBatches ? (kChunkSizeBytes / (kBitsPerPixel / 8))
                        : (kWidth * kHeight);
 
+  // Rectangle in panel coordinates. |x1| and |y1| are exclusive.
+  struct Rect {
+    uint8_t x0;
+    uint8_t y0;
+    uint8_t x1;
+    uint8_t y1;
+
+    uint16_t width() const { return x1 - x0; }
+    uint16_t height() const { return y1 - y0; }
+    uint16_t area() const { return width() * height(); }
+  };
+
+  // A graphic acceleration operation, see Execute().
+  struct DrawCommand {
+    enum Type : uint8_t {
+      kCopy,  // Copies |rect| to (|x|, |y|).
+      kFill,  // Fills |rect| with |color|.
+    };
+    Type type;
+    Rect rect;
+    uint8_t x;
+    uint8_t y;
+    uint16_t color;  // RGB565.
+  };
+
+  // Approximate cost of executing one command in terms of pixel data bytes
+  // that could have been sent at 40 MHz in the same time instead.
+  constexpr static size_t kCommandCostBytes =
+      kAccelerationDelayUs * 40 / 8 + 11;
+
+  // Counters for the last scan-out.
+  struct ScanoutStats {
+    uint32_t chunks = 0;
+    // Batches that had to wait for a buffer because both were in flight.
+    uint32_t render_stalls = 0;
+    // Batches submitted after the bus had run out of data within a rectangle.
+    uint32_t transfer_stalls = 0;
+  };
+
   SSD1331();
   ~SSD1331();
 
@@ -76,47 +140,135 @@ class SSD1331 {
   void Fill(uint8_t r, uint8_t g, uint8_t b);
   void Enable(bool);
 
+  // Runs graphic acceleration commands in order. Copies within the panel
+  // memory are done in row order, so a copy downwards must not overlap its
+  // destination.
+  void Execute(const DrawCommand* commands, size_t count);
+
+  // Switches the color mode at runtime. The renderer must produce pixels in
+  // the new format from the next scan-out on, so switch through
+  // RainbowFX::SetColorMode(), which changes both.
+  void SetColorMode(ColorMode mode);
+  ColorMode color_mode() const { return color_mode_; }
+
+  const ScanoutStats& scanout_stats() const { return scanout_stats_; }
+  void set_async_scanout(bool enabled) { async_scanout_ = enabled; }
+
+  // Scans out the entire screen. The renderer is called with a pixel buffer
+  // and the number of pixels to produce, in scan order.
   template <typename Renderer>
   inline void IRAM_ATTR Render(const Renderer& renderer) {
-    WriteCommand(CMD_SETCOLUMN);
-    WriteCommand(0);
-    WriteCommand(kWidth - 1);
-    WriteCommand(CMD_SETROW);
-    WriteCommand(0);
-    WriteCommand(kHeight - 1);
-
-    uint32_t* pixels = reinterpret_cast<uint32_t*>(&pixels_[0]);
-    static_assert((kWidth * kHeight * kBitsPerPixel / 8) % kChunkSizeBytes == 0,
-                  "Partial chunks not supported");
-
-    if (kRenderInBatches) {
-      // Render the screen in small batches to parallelize with the screen
-      // update DMA.
-      size_t batch_count = kWidth * kHeight / kRenderBatchPixels;
-      while (batch_count--) {
-        renderer(pixels);
-        WriteData(pixels, kChunkSizeBytes);
-      }
-    } else {
-      // Render the entire screen up front and then scan out.
-      renderer(pixels);
-      const uint32_t* pixels_end =
-          reinterpret_cast<const uint32_t*>(&pixels_[pixels_.size()]);
-      while (pixels < pixels_end) {
-        WriteData(pixels, kChunkSizeBytes);
-        pixels += kChunkSizeBytes / sizeof(uint32_t);
+    constexpr Rect kFullScreen = {0, 0, kWidth, kHeight};
+    Render(&kFullScreen, 1, renderer);
+  }
+
+  // Scans out only the given rectangles, one after the other. Rectangles must
+  // start at an even column and have an even width so that each row is a
+  // whole number of pixel pairs.
+  template <typename Renderer>
+  inline void IRAM_ATTR Render(const Rect* rects,
+                               size_t rect_count,
+                               const Renderer& renderer) {
+    scanout_stats_ = ScanoutStats();
+    const size_t bits_per_pixel = BitsPerPixel(color_mode_);
+    const size_t max_batch_pixels =
+        kRenderInBatches ? kChunkSizeBytes * 8 / bits_per_pixel
+                         : kWidth * kHeight;
+    for (size_t i = 0; i < rect_count; i++) {
+      const Rect& rect = rects[i];
+      WriteCommand(CMD_SETCOLUMN);
+      WriteCommand(rect.x0);
+      WriteCommand(rect.x1 - 1);
+      WriteCommand(CMD_SETROW);
+      WriteCommand(rect.y0);
+      WriteCommand(rect.y1 - 1);
+
+      uint32_t* pixels = pixels_.data();
+      size_t pixel_count = rect.area();
+
+      if (kRenderInBatches) {
+        // Render the rectangle in small batches, each into one of two chunk
+        // buffers, while the other one is being transferred. The last batch
+        // may be partial.
+        bool first = true;
+        while (pixel_count) {
+          size_t batch_pixels = std::min(pixel_count, max_batch_pixels);
+          uint32_t* chunk = AcquireChunk();
+          renderer(chunk, batch_pixels);
+          SubmitChunk(batch_pixels * bits_per_pixel / 8, first);
+          pixel_count -= batch_pixels;
+          first = false;
+        }
+      } else {
+        // Render the entire rectangle up front and then scan out.
+        renderer(pixels, pixel_count);
+        size_t bytes = pixel_count * bits_per_pixel / 8;
+        while (bytes) {
+          size_t chunk_bytes = std::min(bytes, kChunkSizeBytes);
+          WriteData(pixels, chunk_bytes);
+          pixels += chunk_bytes / sizeof(uint32_t);
+          bytes -= chunk_bytes;
+        }
       }
     }
   }
 
  private:
+  constexpr static size_t kChunkWords = kChunkSizeBytes / sizeof(uint32_t);
+
+  uint8_t Remap() const {
+    uint8_t remap = 0x72;
+    if (kColorOrder == COLOR_ORDER_RGB)
+      remap |= 0xb100;
+    if (kFlipHorizontally)
+      remap &= ~0b10;
+    if (kFlipVertically)
+      remap &= ~0b10000;
+    // Bits 7:6 select the color depth.
+    if (color_mode_ == COLOR_MODE_256)
+      remap &= ~0b01000000;
+    return remap;
+  }
   void IRAM_ATTR WriteCommand(uint16_t cmd);
+  void IRAM_ATTR SendCommands();
   void IRAM_ATTR WriteData(const uint32_t* data, size_t bytes);
+  void IRAM_ATTR StartTransfer(const uint32_t* data,
+                               size_t bytes,
+                               bool data_mode);
+
+  // Returns the next free chunk buffer, waiting if both are in flight.
+  uint32_t* IRAM_ATTR AcquireChunk();
+  // Queues the chunk returned by AcquireChunk() for transfer. |first| is set
+  // for the first chunk of a rectangle, when the bus is expected to be idle.
+  void IRAM_ATTR SubmitChunk(size_t bytes, bool first);
+  // Sends pending commands and waits until everything has been transferred.
+  void IRAM_ATTR Flush();
+  void IRAM_ATTR WaitForIdle();
+  void IRAM_ATTR StartChunk();
+  static void IRAM_ATTR OnTransferDone(void* arg);
+
+  ColorMode color_mode_ = kColorMode;
 
-  std::array<uint16_t,
-             (kRenderInBatches ? kRenderBatchPixels : (kWidth * kHeight)) *
-                 kBitsPerPixel / (sizeof(uint16_t) * 8)>
+  // Two chunk buffers when rendering in batches, or the whole screen.
+  std::array<uint32_t,
+             kRenderInBatches ? 2 * kChunkWords : kWidth * kHeight * 16 / 32>
       pixels_ __attribute__((aligned));
+
+  // Commands not sent yet.
+  std::array<uint32_t, kChunkWords> commands_;
+  size_t command_bytes_ = 0;
+
+  // Chunks are numbered in submission order; chunk n uses buffer n % 2.
+  std::array<size_t, 2> chunk_bytes_ = {};
+  volatile uint32_t submitted_chunks_ = 0;
+  volatile uint32_t completed_chunks_ = 0;
+  // Whether a transfer is in progress, and whether it's a chunk.
+  volatile bool busy_ = false;
+  volatile bool chunk_active_ = false;
+  bool data_mode_ = false;
+
+  bool async_scanout_ = kAsyncScanout;
+  ScanoutStats scanout_stats_;
 };
 
 using Display = SSD1331;
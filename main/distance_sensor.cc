@@ -1,13 +1,35 @@
 #include "distance_sensor.h"
 
+#include <FreeRTOS.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "calibration_store.h"
 #include "i2c.h"
+#include "i2c_transaction.h"
+#include "register_shadow.h"
 #include "third_party/VL53L1_register_map.h"
 
+// Read the shadowed registers back every this many measurements, and report
+// those the shadow got wrong. 0 disables the check.
+constexpr uint32_t kShadowVerifyPeriod = 0;
+
+// Where the sensor's calibration is kept in flash, and the tag of its layout,
+// to be bumped when the layout changes.
+constexpr char kCalibrationKey[] = "vl53l1x";
+constexpr uint32_t kCalibrationTag = 0x564c0001;
+
 // Driver for the VL53L1X distance sensor. Based on
 // https://github.com/pololu/vl53l1x-arduino.
 class VL53L1X : public DistanceSensor {
   constexpr static uint8_t kI2CAddress = 0x29;
   constexpr static uint16_t kTargetRate = 0x0A00;
+  // The configuration registers, which are only written by the driver. ST's
+  // drivers write them as one block of defaults.
+  constexpr static uint16_t kShadowFirst = VL53L1_PAD_I2C_HV__CONFIG;
+  constexpr static uint16_t kShadowEnd = VL53L1_SYSTEM__INTERRUPT_CLEAR;
 
   struct __attribute__((packed)) RangeResults {
     uint8_t range_status;
@@ -33,80 +55,117 @@ class VL53L1X : public DistanceSensor {
   }
 
   void Start(uint32_t period_ms) override {
-    WriteReg32(VL53L1_SYSTEM__INTERMEASUREMENT_PERIOD,
-               period_ms * osc_calibrate_val_);
-    WriteReg8(VL53L1_SYSTEM__INTERRUPT_CLEAR,
-              0x01);                             // sys_interrupt_clear_range
-    WriteReg8(VL53L1_SYSTEM__MODE_START, 0x40);  // mode_range__timed
+    period_ms_ = period_ms;
+    I2CTransaction transaction(kI2CAddress, &shadow_);
+    // With calibration at hand, the first measurement can skip VHV and
+    // phasecal like the rest.
+    if (have_calibration_) {
+      WriteManualCalibration(transaction);
+      calibrated_ = true;
+    }
+    transaction.Write32(VL53L1_SYSTEM__INTERMEASUREMENT_PERIOD,
+                        period_ms * osc_calibrate_val_);
+    transaction.Write8(VL53L1_SYSTEM__INTERRUPT_CLEAR,
+                       0x01);  // sys_interrupt_clear_range
+    transaction.Write8(VL53L1_SYSTEM__MODE_START,
+                       0x40);  // mode_range__timed
+    transaction.Submit();
   }
 
   void Stop() override {
-    WriteReg8(VL53L1_SYSTEM__MODE_START, 0x80);  // mode_range__abort
+    I2CTransaction transaction(kI2CAddress, &shadow_);
+    transaction.Write8(VL53L1_SYSTEM__MODE_START,
+                       0x80);  // mode_range__abort
     calibrated_ = false;
 
     // "restore vhv configs"
-    if (saved_vhv_init_) {
-      WriteReg8(VL53L1_VHV_CONFIG__INIT, saved_vhv_init_);
+    if (calibration_.vhv_init) {
+      transaction.Write8(VL53L1_VHV_CONFIG__INIT, calibration_.vhv_init);
     }
-    if (saved_vhv_timeout_) {
-      WriteReg8(VL53L1_VHV_CONFIG__TIMEOUT_MACROP_LOOP_BOUND,
-                saved_vhv_timeout_);
+    if (calibration_.vhv_timeout) {
+      transaction.Write8(VL53L1_VHV_CONFIG__TIMEOUT_MACROP_LOOP_BOUND,
+                         calibration_.vhv_timeout);
     }
 
     // "remove phasecal override"
-    WriteReg8(VL53L1_PHASECAL_CONFIG__OVERRIDE, 0x00);
+    transaction.Write8(VL53L1_PHASECAL_CONFIG__OVERRIDE, 0x00);
+    transaction.Submit();
   }
 
   void SetRange(Range range) override {
+    // The SD config registers are contiguous and go out as one burst.
+    I2CTransaction transaction(kI2CAddress, &shadow_);
+    WriteRangeConfig(range, transaction);
+    transaction.Submit();
+  }
+
+  // Writes the timing and dynamic config for |range| to |registers|, an
+  // I2CTransaction or a ConfigImage.
+  template <typename Registers>
+  static void WriteRangeConfig(Range range, Registers& registers) {
     switch (range) {
       case Range::kShort:
         // Timing config.
-        WriteReg8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A, 0x07);
-        WriteReg8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_B, 0x05);
-        WriteReg8(VL53L1_RANGE_CONFIG__VALID_PHASE_HIGH, 0x38);
+        registers.Write8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A, 0x07);
+        registers.Write8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_B, 0x05);
+        registers.Write8(VL53L1_RANGE_CONFIG__VALID_PHASE_HIGH, 0x38);
 
         // Dynamic config.
-        WriteReg8(VL53L1_SD_CONFIG__WOI_SD0, 0x07);
-        WriteReg8(VL53L1_SD_CONFIG__WOI_SD1, 0x05);
-        WriteReg8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD0,
-                  6);  // Tuning parm default.
-        WriteReg8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD1,
-                  6);  // Tuning parm default.
+        registers.Write8(VL53L1_SD_CONFIG__WOI_SD0, 0x07);
+        registers.Write8(VL53L1_SD_CONFIG__WOI_SD1, 0x05);
+        registers.Write8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD0,
+                         6);  // Tuning parm default.
+        registers.Write8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD1,
+                         6);  // Tuning parm default.
         break;
 
       case Range::kMedium:
         // Timing config.
-        WriteReg8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A, 0x0B);
-        WriteReg8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_B, 0x09);
-        WriteReg8(VL53L1_RANGE_CONFIG__VALID_PHASE_HIGH, 0x78);
+        registers.Write8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A, 0x0B);
+        registers.Write8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_B, 0x09);
+        registers.Write8(VL53L1_RANGE_CONFIG__VALID_PHASE_HIGH, 0x78);
 
         // Dynamic config.
-        WriteReg8(VL53L1_SD_CONFIG__WOI_SD0, 0x0B);
-        WriteReg8(VL53L1_SD_CONFIG__WOI_SD1, 0x09);
-        WriteReg8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD0,
-                  10);  // Tuning parm default
-        WriteReg8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD1,
-                  10);  // Tuning parm default.
+        registers.Write8(VL53L1_SD_CONFIG__WOI_SD0, 0x0B);
+        registers.Write8(VL53L1_SD_CONFIG__WOI_SD1, 0x09);
+        registers.Write8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD0,
+                         10);  // Tuning parm default
+        registers.Write8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD1,
+                         10);  // Tuning parm default.
         break;
 
       case Range::kLong:
         // Timing config.
-        WriteReg8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A, 0x0F);
-        WriteReg8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_B, 0x0D);
-        WriteReg8(VL53L1_RANGE_CONFIG__VALID_PHASE_HIGH, 0xB8);
+        registers.Write8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A, 0x0F);
+        registers.Write8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_B, 0x0D);
+        registers.Write8(VL53L1_RANGE_CONFIG__VALID_PHASE_HIGH, 0xB8);
 
         // Dynamic config.
-        WriteReg8(VL53L1_SD_CONFIG__WOI_SD0, 0x0F);
-        WriteReg8(VL53L1_SD_CONFIG__WOI_SD1, 0x0D);
-        WriteReg8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD0,
-                  14);  // Tuning parm default.
-        WriteReg8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD1,
-                  14);  // Tuning parm default.
+        registers.Write8(VL53L1_SD_CONFIG__WOI_SD0, 0x0F);
+        registers.Write8(VL53L1_SD_CONFIG__WOI_SD1, 0x0D);
+        registers.Write8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD0,
+                         14);  // Tuning parm default.
+        registers.Write8(VL53L1_SD_CONFIG__INITIAL_PHASE_SD1,
+                         14);  // Tuning parm default.
         break;
     }
   }
 
   void SetMeasurementTimingBudget(uint32_t budget_us) {
+    I2CTransaction transaction(kI2CAddress, &shadow_);
+    WriteTimingBudget(budget_us, ReadReg8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A),
+                      ReadReg8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_B),
+                      transaction);
+    transaction.Submit();
+  }
+
+  // Writes the timeouts for |budget_us| at the given VCSEL periods to
+  // |registers|, an I2CTransaction or a ConfigImage.
+  template <typename Registers>
+  void WriteTimingBudget(uint32_t budget_us,
+                         uint8_t vcsel_period_a,
+                         uint8_t vcsel_period_b,
+                         Registers& registers) {
     // vhv = LOWPOWER_AUTO_VHV_LOOP_DURATION_US + LOWPOWERAUTO_VHV_LOOP_BOUND
     //       (tuning parm default) * LOWPOWER_AUTO_VHV_LOOP_DURATION_US
     //     = 245 + 3 * 245 = 980
@@ -123,8 +182,7 @@ class VL53L1X : public DistanceSensor {
     uint32_t range_config_timeout_us = budget_us / 2;
 
     // "Update Macro Period for Range A VCSEL Period"
-    uint32_t macro_period_us =
-        CalcMacroPeriod(ReadReg8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A));
+    uint32_t macro_period_us = CalcMacroPeriod(vcsel_period_a);
 
     // "Update Phase timeout - uses Timing A"
     // Timeout of 1000 is tuning parm default
@@ -133,7 +191,8 @@ class VL53L1X : public DistanceSensor {
     uint32_t phasecal_timeout_mclks =
         TimeoutMicrosecondsToMclks(1000, macro_period_us);
     phasecal_timeout_mclks = std::min(0xffu, phasecal_timeout_mclks);
-    WriteReg8(VL53L1_PHASECAL_CONFIG__TIMEOUT_MACROP, phasecal_timeout_mclks);
+    registers.Write8(VL53L1_PHASECAL_CONFIG__TIMEOUT_MACROP,
+                     phasecal_timeout_mclks);
 
     // "Update MM Timing A timeout"
     // Timeout of 1 is tuning parm default
@@ -143,27 +202,28 @@ class VL53L1X : public DistanceSensor {
     // retrieved, recalculated with a different macro period, and reassigned,
     // but it probably doesn't matter because it seems like the MM ("mode
     // mitigation"?) sequence steps are disabled in low power auto mode anyway.
-    WriteReg16(VL53L1_MM_CONFIG__TIMEOUT_MACROP_A,
-               EncodeTimeout(TimeoutMicrosecondsToMclks(1, macro_period_us)));
+    registers.Write16(
+        VL53L1_MM_CONFIG__TIMEOUT_MACROP_A,
+        EncodeTimeout(TimeoutMicrosecondsToMclks(1, macro_period_us)));
 
     // "Update Range Timing A timeout"
-    WriteReg16(VL53L1_RANGE_CONFIG__TIMEOUT_MACROP_A,
-               EncodeTimeout(TimeoutMicrosecondsToMclks(range_config_timeout_us,
-                                                        macro_period_us)));
+    registers.Write16(VL53L1_RANGE_CONFIG__TIMEOUT_MACROP_A,
+                      EncodeTimeout(TimeoutMicrosecondsToMclks(
+                          range_config_timeout_us, macro_period_us)));
 
     // "Update Macro Period for Range B VCSEL Period"
-    macro_period_us =
-        CalcMacroPeriod(ReadReg8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_B));
+    macro_period_us = CalcMacroPeriod(vcsel_period_b);
 
     // "Update MM Timing B timeout"
     // (See earlier comment about MM Timing A timeout.)
-    WriteReg16(VL53L1_MM_CONFIG__TIMEOUT_MACROP_B,
-               EncodeTimeout(TimeoutMicrosecondsToMclks(1, macro_period_us)));
+    registers.Write16(
+        VL53L1_MM_CONFIG__TIMEOUT_MACROP_B,
+        EncodeTimeout(TimeoutMicrosecondsToMclks(1, macro_period_us)));
 
     // "Update Range Timing B timeout"
-    WriteReg16(VL53L1_RANGE_CONFIG__TIMEOUT_MACROP_B,
-               EncodeTimeout(TimeoutMicrosecondsToMclks(range_config_timeout_us,
-                                                        macro_period_us)));
+    registers.Write16(VL53L1_RANGE_CONFIG__TIMEOUT_MACROP_B,
+                      EncodeTimeout(TimeoutMicrosecondsToMclks(
+                          range_config_timeout_us, macro_period_us)));
 #if 0
     uint32_t eff_macro_period_us =
         CalcMacroPeriod(ReadReg8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A));
@@ -179,7 +239,7 @@ class VL53L1X : public DistanceSensor {
   }
 
   bool GetDistanceMM(uint32_t& distance_mm) override {
-    if (ReadReg8(VL53L1_GPIO__TIO_HV_STATUS) & 0x01)
+    if (!status_read_.Submit() || (status_ & 0x01))
       return false;
 
     RangeResults range_results;
@@ -204,15 +264,37 @@ class VL53L1X : public DistanceSensor {
            range_results.peak_signal_count_rate_crosstalk_corrected_mcps_sd0);
 #endif
 
-    if (!calibrated_) {
+    if (!calibrated_)
       SetupManualCalibration();
-      calibrated_ = true;
+    // The SPAD target tends to stay put, and then only the interrupt is
+    // cleared.
+    uint16_t required_spads = CalculateRequiredSpads(range_results);
+    required_spads_[0] = required_spads >> 8;
+    required_spads_[1] = required_spads & 0xff;
+    if (shadow_.Write(VL53L1_DSS_CONFIG__MANUAL_EFFECTIVE_SPADS_SELECT,
+                      required_spads_, sizeof(required_spads_))) {
+      if (!dss_update_.Submit())
+        shadow_.Clear();
+    } else {
+      interrupt_clear_.Submit();
+    }
+
+    if (kShadowVerifyPeriod && ++measurements_ == kShadowVerifyPeriod) {
+      measurements_ = 0;
+      uint32_t mismatches = shadow_.Verify(kI2CAddress);
+      if (mismatches)
+        printf("VL53L1X: %u shadowed registers were stale\n", mismatches);
     }
-    UpdateDSS(range_results);
-    WriteReg8(VL53L1_SYSTEM__INTERRUPT_CLEAR,
-              0x01);  // sys_interrupt_clear_range
 
     constexpr uint8_t kRangeComplete = 9;
+    if (calibration_unconfirmed_) {
+      if (IsHardwareFailure(range_results.range_status)) {
+        Recalibrate();
+        return false;
+      }
+      if (range_results.range_status == kRangeComplete)
+        calibration_unconfirmed_ = false;
+    }
     if (range_results.range_status != kRangeComplete ||
         !range_results.stream_count) {
       return false;
@@ -229,97 +311,206 @@ class VL53L1X : public DistanceSensor {
   }
 
  private:
-  VL53L1X() = default;
+  // The transactions of a measurement are built once and reused, as
+  // building one allocates.
+  VL53L1X()
+      : shadow_(kShadowFirst, kShadowEnd),
+        status_read_(kI2CAddress),
+        results_read_(kI2CAddress),
+        dss_update_(kI2CAddress),
+        interrupt_clear_(kI2CAddress) {
+    shadow_.SetVolatile(VL53L1_GPIO__TIO_HV_STATUS);
+    shadow_.SetVolatile(VL53L1_GPIO__FIO_HV_STATUS);
+
+    status_read_.Read(VL53L1_GPIO__TIO_HV_STATUS, &status_, 1);
+    results_read_.Read(VL53L1_RESULT__RANGE_STATUS,
+                       reinterpret_cast<uint8_t*>(&raw_results_),
+                       sizeof(raw_results_));
+    dss_update_.WriteFrom(VL53L1_DSS_CONFIG__MANUAL_EFFECTIVE_SPADS_SELECT,
+                          required_spads_, sizeof(required_spads_));
+    dss_update_.Write8(VL53L1_SYSTEM__INTERRUPT_CLEAR,
+                       0x01);  // sys_interrupt_clear_range
+    interrupt_clear_.Write8(VL53L1_SYSTEM__INTERRUPT_CLEAR, 0x01);
+  }
+
+  // The configuration block, kShadowFirst up to kShadowEnd, as a register
+  // image. The registers set in it are written in one transaction, each run
+  // of consecutive ones as a burst, in address order.
+  struct ConfigImage {
+    static constexpr size_t kSize = kShadowEnd - kShadowFirst;
+    uint8_t bytes[kSize] = {};
+    bool set[kSize] = {};
+
+    // Only for registers already set.
+    uint8_t Read8(uint16_t reg) const { return bytes[reg - kShadowFirst]; }
+    void Write8(uint16_t reg, uint8_t value) {
+      bytes[reg - kShadowFirst] = value;
+      set[reg - kShadowFirst] = true;
+    }
+    void Write16(uint16_t reg, uint16_t value) {
+      Write8(reg, value >> 8);
+      Write8(reg + 1, value & 0xff);
+    }
+
+    void WriteTo(I2CTransaction& transaction) const {
+      size_t i = 0;
+      while (i < kSize) {
+        if (!set[i]) {
+          i++;
+          continue;
+        }
+        size_t end = i + 1;
+        while (end < kSize && set[end])
+          end++;
+        transaction.Write(kShadowFirst + i, bytes + i, end - i);
+        i = end;
+      }
+    }
+  };
 
   bool Initialize() {
     // Do a software reset.
     WriteReg8(VL53L1_SOFT_RESET, 0x00);
     os_delay_us(100);
     WriteReg8(VL53L1_SOFT_RESET, 0x01);
+    shadow_.Clear();
 
-    auto model = ReadReg16(VL53L1_IDENTIFICATION__MODEL_ID);
-    if (model != 0xeacc) {
-      printf("VL53L1X: Unexpected model: %x\n", model);
+    if (!WaitForBoot()) {
+      printf("VL53L1X: Boot timeout\n");
       return false;
     }
 
-    constexpr int kTimeout = 100;
-    for (int i = 0; i < kTimeout; i++) {
-      if (ReadReg8(VL53L1_FIRMWARE__SYSTEM_STATUS) & 0x01)
-        break;
-      if (i == kTimeout) {
-        printf("VL53L1X: Boot timeout\n");
-        return false;
-      }
-      os_delay_us(100);
+    // The identification and calibration in one transaction. The calibration
+    // kept in flash saves reading most of it, and is only used if the
+    // oscillator frequency, which differs from part to part, matches.
+    Calibration stored;
+    bool loaded = LoadCalibration(kCalibrationKey, kCalibrationTag, &stored,
+                                  sizeof(stored));
+    uint8_t model[2] = {};
+    I2CTransaction reads(kI2CAddress, &shadow_);
+    reads.Read(VL53L1_OSC_MEASURED__FAST_OSC__FREQUENCY,
+               calibration_.fast_osc_frequency,
+               sizeof(calibration_.fast_osc_frequency));
+    if (!loaded)
+      ReadFactoryCalibration(reads);
+    reads.Read(VL53L1_IDENTIFICATION__MODEL_ID, model, sizeof(model));
+    reads.Submit();
+
+    uint16_t model_id = (model[0] << 8) | model[1];
+    if (model_id != 0xeacc) {
+      printf("VL53L1X: Unexpected model: %x\n", model_id);
+      return false;
     }
+    if (loaded && !memcmp(stored.fast_osc_frequency,
+                          calibration_.fast_osc_frequency,
+                          sizeof(stored.fast_osc_frequency))) {
+      calibration_ = stored;
+      have_calibration_ = true;
+      calibration_unconfirmed_ = true;
+      stored_calibration_ = stored;
+      calibration_stored_ = true;
+    } else if (loaded) {
+      printf("VL53L1X: Calibration in flash is for another part\n");
+      I2CTransaction factory_reads(kI2CAddress, &shadow_);
+      ReadFactoryCalibration(factory_reads);
+      factory_reads.Submit();
+    }
+    fast_osc_frequency_ = (calibration_.fast_osc_frequency[0] << 8) |
+                          calibration_.fast_osc_frequency[1];
+    osc_calibrate_val_ = (calibration_.osc_calibrate_val[0] << 8) |
+                         calibration_.osc_calibrate_val[1];
 
-    // Switch to 2V8 mode.
-    WriteReg8(VL53L1_PAD_I2C_HV__EXTSUP_CONFIG,
-              ReadReg8(VL53L1_PAD_I2C_HV__EXTSUP_CONFIG) | 0x01);
+    // The configuration is laid out in an image rather than written
+    // register by register, so that it goes out in a few bursts.
+    ConfigImage image;
 
-    fast_osc_frequency_ = ReadReg16(VL53L1_OSC_MEASURED__FAST_OSC__FREQUENCY);
-    osc_calibrate_val_ = ReadReg16(VL53L1_RESULT__OSC_CALIBRATE_VAL);
+    // Switch to 2V8 mode.
+    image.Write8(VL53L1_PAD_I2C_HV__EXTSUP_CONFIG,
+                 calibration_.extsup_config | 0x01);
 
     // Static config (applied at the beginning of a measurement).
-    WriteReg16(VL53L1_DSS_CONFIG__TARGET_TOTAL_RATE_MCPS, kTargetRate);
-    WriteReg8(VL53L1_GPIO__TIO_HV_STATUS, 0x02);
-    WriteReg8(VL53L1_SIGMA_ESTIMATOR__EFFECTIVE_PULSE_WIDTH_NS,
-              8);  // Tuning parm default.
-    WriteReg8(VL53L1_SIGMA_ESTIMATOR__EFFECTIVE_AMBIENT_WIDTH_NS,
-              16);  // Tuning parm default.
-    WriteReg8(VL53L1_ALGO__CROSSTALK_COMPENSATION_VALID_HEIGHT_MM, 0x01);
-    WriteReg8(VL53L1_ALGO__RANGE_IGNORE_VALID_HEIGHT_MM, 0xFF);
-    WriteReg8(VL53L1_ALGO__RANGE_MIN_CLIP, 0);  // Tuning parm default.
-    WriteReg8(VL53L1_ALGO__CONSISTENCY_CHECK__TOLERANCE,
-              2);  // Tuning parm default.
+    image.Write8(VL53L1_GPIO__TIO_HV_STATUS, 0x02);
+    image.Write8(VL53L1_SIGMA_ESTIMATOR__EFFECTIVE_PULSE_WIDTH_NS,
+                 8);  // Tuning parm default.
+    image.Write8(VL53L1_SIGMA_ESTIMATOR__EFFECTIVE_AMBIENT_WIDTH_NS,
+                 16);  // Tuning parm default.
+    image.Write8(VL53L1_ALGO__CROSSTALK_COMPENSATION_VALID_HEIGHT_MM, 0x01);
+    image.Write8(VL53L1_ALGO__RANGE_IGNORE_VALID_HEIGHT_MM, 0xFF);
+    image.Write8(VL53L1_ALGO__RANGE_MIN_CLIP, 0);  // Tuning parm default.
+    image.Write8(VL53L1_ALGO__CONSISTENCY_CHECK__TOLERANCE,
+                 2);  // Tuning parm default.
 
     // General config.
-    WriteReg16(VL53L1_SYSTEM__THRESH_RATE_HIGH, 0x0000);
-    WriteReg16(VL53L1_SYSTEM__THRESH_RATE_LOW, 0x0000);
-    WriteReg8(VL53L1_DSS_CONFIG__APERTURE_ATTENUATION, 0x38);
+    image.Write16(VL53L1_SYSTEM__THRESH_RATE_HIGH, 0x0000);
+    image.Write16(VL53L1_SYSTEM__THRESH_RATE_LOW, 0x0000);
+    image.Write8(VL53L1_DSS_CONFIG__APERTURE_ATTENUATION, 0x38);
 
     // Timing config.
-    WriteReg16(VL53L1_RANGE_CONFIG__SIGMA_THRESH, 360);  // tuning parm default
-    WriteReg16(VL53L1_RANGE_CONFIG__MIN_COUNT_RATE_RTN_LIMIT_MCPS,
-               192);  // tuning parm default
+    image.Write16(VL53L1_RANGE_CONFIG__SIGMA_THRESH,
+                  360);  // tuning parm default
+    image.Write16(VL53L1_RANGE_CONFIG__MIN_COUNT_RATE_RTN_LIMIT_MCPS,
+                  192);  // tuning parm default
 
     // Dynamic config.
-    WriteReg8(VL53L1_SYSTEM__GROUPED_PARAMETER_HOLD_0, 0x01);
-    WriteReg8(VL53L1_SYSTEM__GROUPED_PARAMETER_HOLD_1, 0x01);
-    WriteReg8(VL53L1_SD_CONFIG__QUANTIFIER, 2);  // tuning parm default
+    image.Write8(VL53L1_SYSTEM__GROUPED_PARAMETER_HOLD_0, 0x01);
+    image.Write8(VL53L1_SYSTEM__GROUPED_PARAMETER_HOLD_1, 0x01);
+    image.Write8(VL53L1_SD_CONFIG__QUANTIFIER, 2);  // tuning parm default
 
-    WriteReg8(VL53L1_SYSTEM__GROUPED_PARAMETER_HOLD, 0x00);
-    WriteReg8(VL53L1_SYSTEM__SEED_CONFIG, 1);  // tuning parm default
+    image.Write8(VL53L1_SYSTEM__GROUPED_PARAMETER_HOLD, 0x00);
+    image.Write8(VL53L1_SYSTEM__SEED_CONFIG, 1);  // tuning parm default
 
     // from VL53L1_config_low_power_auto_mode
-    WriteReg8(VL53L1_SYSTEM__SEQUENCE_CONFIG,
-              0x8B);  // VHV, PHASECAL, DSS1, RANGE
-    WriteReg16(VL53L1_DSS_CONFIG__MANUAL_EFFECTIVE_SPADS_SELECT, 200 << 8);
-    WriteReg8(VL53L1_DSS_CONFIG__ROI_MODE_CONTROL,
-              2);  // REQUESTED_EFFFECTIVE_SPADS
+    image.Write8(VL53L1_SYSTEM__SEQUENCE_CONFIG,
+                 0x8B);  // VHV, PHASECAL, DSS1, RANGE
+    image.Write16(VL53L1_DSS_CONFIG__MANUAL_EFFECTIVE_SPADS_SELECT, 200 << 8);
+    image.Write8(VL53L1_DSS_CONFIG__ROI_MODE_CONTROL,
+                 2);  // REQUESTED_EFFFECTIVE_SPADS
+
+    WriteRangeConfig(Range::kMedium, image);
+    WriteTimingBudget(50000,
+                      image.Read8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_A),
+                      image.Read8(VL53L1_RANGE_CONFIG__VCSEL_PERIOD_B), image);
+
+    // Along with the two registers below the block.
+    I2CTransaction writes(kI2CAddress, &shadow_);
+    writes.Write16(VL53L1_ALGO__PART_TO_PART_RANGE_OFFSET_MM,
+                   ((calibration_.outer_offset_mm[0] << 8) |
+                    calibration_.outer_offset_mm[1]) *
+                       4);
+    writes.Write16(VL53L1_DSS_CONFIG__TARGET_TOTAL_RATE_MCPS, kTargetRate);
+    image.WriteTo(writes);
+    return writes.Submit();
+  }
 
-    SetRange(Range::kMedium);
-    SetMeasurementTimingBudget(50000);
+  // Adds reading the calibration the part was given at the factory to
+  // |reads|.
+  void ReadFactoryCalibration(I2CTransaction& reads) {
+    reads.Read(VL53L1_MM_CONFIG__OUTER_OFFSET_MM, calibration_.outer_offset_mm,
+               sizeof(calibration_.outer_offset_mm));
+    reads.Read(VL53L1_PAD_I2C_HV__EXTSUP_CONFIG, &calibration_.extsup_config,
+               1);
+    reads.Read(VL53L1_RESULT__OSC_CALIBRATE_VAL, calibration_.osc_calibrate_val,
+               sizeof(calibration_.osc_calibrate_val));
+  }
 
-    WriteReg16(VL53L1_ALGO__PART_TO_PART_RANGE_OFFSET_MM,
-               ReadReg16(VL53L1_MM_CONFIG__OUTER_OFFSET_MM) * 4);
-    return true;
+  // Polls the firmware status until the sensor has booted, which the
+  // datasheet says takes up to 1.2 ms.
+  bool WaitForBoot() {
+    constexpr uint32_t kPollIntervalUs = 100;
+    constexpr uint32_t kTimeoutUs = 10000;
+    for (uint32_t waited_us = 0;; waited_us += kPollIntervalUs) {
+      if (ReadReg8(VL53L1_FIRMWARE__SYSTEM_STATUS) & 0x01)
+        return true;
+      if (waited_us >= kTimeoutUs)
+        return false;
+      os_delay_us(kPollIntervalUs);
+    }
   }
 
   void ReadResults(RangeResults& range_results) {
     static_assert(sizeof(RangeResults) == 17,
                   "Results structure not packed correctly");
-    uint16_t reg = VL53L1_RESULT__RANGE_STATUS;
-    auto cmd = CreateCommand(I2C_MASTER_WRITE);
-    i2c_master_write_byte(cmd, (reg >> 8) & 0xff, true);
-    i2c_master_write_byte(cmd, reg & 0xff, true);
-    SendCommand(cmd);
-
-    cmd = CreateCommand(I2C_MASTER_READ);
-    i2c_master_read(cmd, reinterpret_cast<uint8_t*>(&range_results),
-                    sizeof(range_results), I2C_MASTER_LAST_NACK);
-    SendCommand(cmd);
+    range_results = results_read_.Submit() ? raw_results_ : RangeResults();
 
     // The data is returned in big endian, so convert to little endian.
     range_results.dss_actual_effective_spads_sd0 =
@@ -337,8 +528,9 @@ class VL53L1X : public DistanceSensor {
             range_results.peak_signal_count_rate_crosstalk_corrected_mcps_sd0);
   }
 
-  // Perform Dynamic SPAD Selection calculation/update.
-  void UpdateDSS(const RangeResults& range_results) {
+  // Perform Dynamic SPAD Selection calculation. Returns the SPAD count to
+  // request.
+  static uint16_t CalculateRequiredSpads(const RangeResults& range_results) {
     uint16_t spad_count = range_results.dss_actual_effective_spads_sd0;
 
     if (spad_count) {
@@ -364,11 +556,9 @@ class VL53L1X : public DistanceSensor {
         required_spads = std::min(0xffffu, required_spads);
 
         // "override DSS config"
-        WriteReg16(VL53L1_DSS_CONFIG__MANUAL_EFFECTIVE_SPADS_SELECT,
-                   required_spads);
         // DSS_CONFIG__ROI_MODE_CONTROL should already be set to
         // REQUESTED_EFFFECTIVE_SPADS.
-        return;
+        return required_spads;
       }
     }
 
@@ -377,92 +567,49 @@ class VL53L1X : public DistanceSensor {
     // with an error"
 
     // "set target to mid point"
-    WriteReg16(VL53L1_DSS_CONFIG__MANUAL_EFFECTIVE_SPADS_SELECT, 0x8000);
+    return 0x8000;
   }
 
   uint8_t ReadReg8(uint16_t reg) {
-    auto cmd = CreateCommand(I2C_MASTER_WRITE);
-    i2c_master_write_byte(cmd, (reg >> 8) & 0xff, false);
-    i2c_master_write_byte(cmd, reg & 0xff, false);
-    SendCommand(cmd);
-
-    uint8_t value;
-    cmd = CreateCommand(I2C_MASTER_READ);
-    i2c_master_read_byte(cmd, &value, I2C_MASTER_LAST_NACK);
-    SendCommand(cmd);
+    uint8_t value = 0;
+    I2CTransaction transaction(kI2CAddress, &shadow_);
+    transaction.Read(reg, &value, 1);
+    transaction.Submit();
     return value;
   }
 
   uint16_t ReadReg16(uint16_t reg) {
-    auto cmd = CreateCommand(I2C_MASTER_WRITE);
-    i2c_master_write_byte(cmd, (reg >> 8) & 0xff, false);
-    i2c_master_write_byte(cmd, reg & 0xff, false);
-    SendCommand(cmd);
-
-    uint8_t value_lo;
-    uint8_t value_hi;
-    cmd = CreateCommand(I2C_MASTER_READ);
-    i2c_master_read_byte(cmd, &value_hi, I2C_MASTER_ACK);
-    i2c_master_read_byte(cmd, &value_lo, I2C_MASTER_LAST_NACK);
-    SendCommand(cmd);
-    return (value_hi << 8) | value_lo;
+    uint8_t values[2] = {};
+    I2CTransaction transaction(kI2CAddress, &shadow_);
+    transaction.Read(reg, values, sizeof(values));
+    transaction.Submit();
+    return (values[0] << 8) | values[1];
   }
 
   uint32_t ReadReg32(uint16_t reg) {
-    auto cmd = CreateCommand(I2C_MASTER_WRITE);
-    i2c_master_write_byte(cmd, (reg >> 8) & 0xff, false);
-    i2c_master_write_byte(cmd, reg & 0xff, false);
-    SendCommand(cmd);
-
-    uint8_t values[4];
-    cmd = CreateCommand(I2C_MASTER_READ);
-    i2c_master_read_byte(cmd, &values[0], I2C_MASTER_ACK);
-    i2c_master_read_byte(cmd, &values[1], I2C_MASTER_ACK);
-    i2c_master_read_byte(cmd, &values[2], I2C_MASTER_ACK);
-    i2c_master_read_byte(cmd, &values[3], I2C_MASTER_LAST_NACK);
-    SendCommand(cmd);
+    uint8_t values[4] = {};
+    I2CTransaction transaction(kI2CAddress, &shadow_);
+    transaction.Read(reg, values, sizeof(values));
+    transaction.Submit();
     return (values[0] << 24) | (values[1] << 16) | (values[2] << 8) | values[3];
   }
 
   void WriteReg8(uint16_t reg, uint8_t value) {
-    auto cmd = CreateCommand(I2C_MASTER_WRITE);
-    i2c_master_write_byte(cmd, (reg >> 8) & 0xff, false);
-    i2c_master_write_byte(cmd, reg & 0xff, false);
-    i2c_master_write_byte(cmd, value, false);
-    SendCommand(cmd);
+    I2CTransaction transaction(kI2CAddress, &shadow_);
+    transaction.Write8(reg, value);
+    transaction.Submit();
   }
 
   void WriteReg16(uint16_t reg, uint16_t value) {
-    auto cmd = CreateCommand(I2C_MASTER_WRITE);
-    i2c_master_write_byte(cmd, (reg >> 8) & 0xff, false);
-    i2c_master_write_byte(cmd, reg & 0xff, false);
-    i2c_master_write_byte(cmd, (value >> 8) & 0xff, false);
-    i2c_master_write_byte(cmd, value & 0xff, false);
-    SendCommand(cmd);
+    I2CTransaction transaction(kI2CAddress, &shadow_);
+    transaction.Write16(reg, value);
+    transaction.Submit();
   }
 
-  void WriteReg32(uint16_t reg, uint16_t value) {
-    auto cmd = CreateCommand(I2C_MASTER_WRITE);
-    i2c_master_write_byte(cmd, (reg >> 8) & 0xff, false);
-    i2c_master_write_byte(cmd, reg & 0xff, false);
-    i2c_master_write_byte(cmd, (value >> 24) & 0xff, false);
-    i2c_master_write_byte(cmd, (value >> 16) & 0xff, false);
-    i2c_master_write_byte(cmd, (value >> 8) & 0xff, false);
-    i2c_master_write_byte(cmd, value & 0xff, false);
-    SendCommand(cmd);
-  }
-
-  static i2c_cmd_handle_t CreateCommand(int flags) {
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (kI2CAddress << 1) | flags, false);
-    return cmd;
-  }
-
-  static void SendCommand(i2c_cmd_handle_t cmd) {
-    i2c_master_stop(cmd);
-    i2c_master_cmd_begin(kI2CPort, cmd, 1000 / portTICK_RATE_MS);
-    i2c_cmd_link_delete(cmd);
+  void WriteReg32(uint16_t reg, uint32_t value) {
+    I2CTransaction transaction(kI2CAddress, &shadow_);
+    transaction.Write32(reg, value);
+    transaction.Submit();
   }
 
   // Convert sequence step timeout from macro periods to microseconds with given
@@ -517,30 +664,147 @@ class VL53L1X : public DistanceSensor {
 
   void SetupManualCalibration() {
     // "save original vhv configs"
-    saved_vhv_init_ = ReadReg8(VL53L1_VHV_CONFIG__INIT);
-    saved_vhv_timeout_ = ReadReg8(VL53L1_VHV_CONFIG__TIMEOUT_MACROP_LOOP_BOUND);
+    I2CTransaction reads(kI2CAddress, &shadow_);
+    reads.Read(VL53L1_VHV_CONFIG__INIT, &calibration_.vhv_init, 1);
+    reads.Read(VL53L1_VHV_CONFIG__TIMEOUT_MACROP_LOOP_BOUND,
+               &calibration_.vhv_timeout, 1);
+    reads.Read(VL53L1_PHASECAL_RESULT__VCSEL_START, &calibration_.vcsel_start,
+               1);
+    if (!reads.Submit())
+      return;
+
+    I2CTransaction writes(kI2CAddress, &shadow_);
+    WriteManualCalibration(writes);
+    writes.Submit();
+    calibrated_ = true;
+    have_calibration_ = true;
+    if (!calibration_stored_ ||
+        memcmp(&calibration_, &stored_calibration_, sizeof(calibration_))) {
+      stored_calibration_ = calibration_;
+      calibration_stored_ = true;
+      portENTER_CRITICAL();
+      unsaved_calibration_ = calibration_;
+      calibration_unsaved_ = true;
+      portEXIT_CRITICAL();
+    }
+  }
 
+  // Adds applying the VHV and phasecal results in |calibration_| to
+  // |transaction|, so that measurements skip both steps.
+  void WriteManualCalibration(I2CTransaction& transaction) {
     // "disable VHV init"
-    WriteReg8(VL53L1_VHV_CONFIG__INIT, saved_vhv_init_ & 0x7F);
+    transaction.Write8(VL53L1_VHV_CONFIG__INIT, calibration_.vhv_init & 0x7F);
 
     // "set loop bound to tuning param"
-    WriteReg8(VL53L1_VHV_CONFIG__TIMEOUT_MACROP_LOOP_BOUND,
-              (saved_vhv_timeout_ & 0x03) +
-                  (3 << 2));  // tuning parm default
-                              // (LOWPOWERAUTO_VHV_LOOP_BOUND_DEFAULT)
+    transaction.Write8(VL53L1_VHV_CONFIG__TIMEOUT_MACROP_LOOP_BOUND,
+                       (calibration_.vhv_timeout & 0x03) +
+                           (3 << 2));  // tuning parm default
+                                       // (LOWPOWERAUTO_VHV_LOOP_BOUND_DEFAULT)
 
     // "override phasecal"
-    WriteReg8(VL53L1_PHASECAL_CONFIG__OVERRIDE, 0x01);
-    WriteReg8(VL53L1_CAL_CONFIG__VCSEL_START,
-              ReadReg8(VL53L1_PHASECAL_RESULT__VCSEL_START));
+    transaction.Write8(VL53L1_PHASECAL_CONFIG__OVERRIDE, 0x01);
+    transaction.Write8(VL53L1_CAL_CONFIG__VCSEL_START,
+                       calibration_.vcsel_start);
+  }
+
+  bool SaveCalibration() override {
+    portENTER_CRITICAL();
+    bool unsaved = calibration_unsaved_;
+    bool rejected = calibration_rejected_;
+    Calibration calibration = unsaved_calibration_;
+    calibration_unsaved_ = false;
+    calibration_rejected_ = false;
+    portEXIT_CRITICAL();
+    if (rejected)
+      printf("VL53L1X: Calibration from flash failed, recalibrating\n");
+    if (unsaved) {
+      return StoreCalibration(kCalibrationKey, kCalibrationTag, &calibration,
+                              sizeof(calibration));
+    }
+    // Not to be loaded on the next boot, if the sensor hasn't calibrated
+    // anew by now.
+    if (rejected)
+      EraseCalibration(kCalibrationKey);
+    return rejected;
+  }
+
+  // Range statuses that report a VCSEL or VHV failure, which stale
+  // calibration can cause, rather than no target in reach.
+  static bool IsHardwareFailure(uint8_t range_status) {
+    switch (range_status & 0x1F) {
+      case 1:   // VCSELCONTINUITYTESTFAILURE
+      case 2:   // VCSELWATCHDOGTESTFAILURE
+      case 3:   // NOVHVVALUEFOUND
+      case 17:  // MULTCLIPFAIL
+        return true;
+      default:
+        return false;
+    }
   }
 
+  // Drops the calibration loaded from flash, which the sensor turned out to
+  // fail with, and restarts with VHV and phasecal enabled, so that the next
+  // measurement calibrates afresh. SaveCalibration() erases it from flash.
+  void Recalibrate() {
+    calibration_stored_ = false;
+    portENTER_CRITICAL();
+    calibration_rejected_ = true;
+    portEXIT_CRITICAL();
+    Stop();
+    have_calibration_ = false;
+    calibration_unconfirmed_ = false;
+    Start(period_ms_);
+  }
+
+  // Register values, big endian, as read.
+  struct __attribute__((packed)) Calibration {
+    // From the factory.
+    uint8_t fast_osc_frequency[2];
+    uint8_t osc_calibrate_val[2];
+    uint8_t outer_offset_mm[2];
+    uint8_t extsup_config;
+    // From the first measurement with VHV and phasecal enabled.
+    uint8_t vhv_init;
+    uint8_t vhv_timeout;
+    uint8_t vcsel_start;
+  };
+  static_assert(sizeof(Calibration) <= kMaxCalibrationSize,
+                "Calibration too large to store");
+
   uint16_t fast_osc_frequency_ = 0;
   uint16_t osc_calibrate_val_ = 0;
 
+  Calibration calibration_ = {};
+  // Whether |calibration_| holds the VHV and phasecal results.
+  bool have_calibration_ = false;
+  // Loaded from flash, and no range has completed with it yet.
+  bool calibration_unconfirmed_ = false;
+  // What flash holds once SaveCalibration() has caught up.
+  Calibration stored_calibration_ = {};
+  bool calibration_stored_ = false;
+  // Handed to SaveCalibration(), which may run on another task, in critical
+  // sections.
+  Calibration unsaved_calibration_ = {};
+  bool calibration_unsaved_ = false;
+  bool calibration_rejected_ = false;
+  // Whether the VHV and phasecal results are applied.
   bool calibrated_ = false;
-  uint8_t saved_vhv_init_ = 0;
-  uint8_t saved_vhv_timeout_ = 0;
+  uint32_t period_ms_ = 0;
+  uint32_t measurements_ = 0;
+
+  RegisterShadow shadow_;
+
+  // GPIO__TIO_HV_STATUS.
+  I2CTransaction status_read_;
+  uint8_t status_ = 0;
+  // Big endian, as read.
+  I2CTransaction results_read_;
+  RangeResults raw_results_ = {};
+  // Writes DSS_CONFIG__MANUAL_EFFECTIVE_SPADS_SELECT from |required_spads_|,
+  // big endian, and clears the interrupt; the shadow is updated separately.
+  I2CTransaction dss_update_;
+  uint8_t required_spads_[2] = {};
+  I2CTransaction interrupt_clear_;
 };
 
 // static
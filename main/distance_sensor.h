@@ -9,6 +9,12 @@ class DistanceSensor {
   virtual void Start(uint32_t period_ms) = 0;
   virtual void Stop() = 0;
   virtual bool GetDistanceMM(uint32_t& distance_mm) = 0;
+  // Stores the sensor's calibration in flash if it changed since it was
+  // loaded or last stored, or erases one the sensor failed with, and returns
+  // whether it wrote flash. Writing flash stalls the CPU for milliseconds, so
+  // this is left to the caller, which may be another task than the one
+  // calling GetDistanceMM().
+  virtual bool SaveCalibration() = 0;
 
   enum class Range {
     kShort,   // Up to 1.3 m.
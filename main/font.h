@@ -6,10 +6,21 @@
 struct Glyph {
  uint8_t width;
  uint8_t height;
+ // Offset into kGlyphData in words, and into kGlyphSpanData in bytes.
  uint16_t offset;
+ uint16_t span_offset;
+ uint16_t span_size;
 };
 
-constexpr uint32_t DRAM_ATTR kGlyphData[] = {
+// A glyph pre-filtered to half size for NativeFX, as drawn at an even or at an
+// odd row.
+struct NativeGlyph {
+ // Offset into kNativeGlyphSpanData in bytes.
+ uint16_t span_offset;
+ uint16_t span_size;
+};
+
+constexpr uint32_t kGlyphData[] = {
   0b00000000000000000000000000000000, 0b00000000000000000000000000000000,
   0b00000000000000000000000000000000, 0b00000000000000000000000000000000,
   0b00000000000000000000000000011111, 0b11111000000000000000000000000000,
@@ -795,17 +806,335 @@ constexpr uint32_t DRAM_ATTR kGlyphData[] = {
   0b00000000000000111111100000000000, 0b00000000000000000000000000000000,
   0b00000000000000000000000000000000, 0b00000000000000000000000000000000,
 };
+constexpr uint32_t kGlyphSpanData[] = {
+  0x1b010000, 0x0e19010a, 0x01131601, 0x13011515, 0x18120217, 0x1101042c,
+  0x24100121, 0x01250f01, 0x0d01270e, 0x290d0128, 0x012a0c01, 0x0b022a0c,
+  0x02152216, 0x1423160b, 0x24160a02, 0x150a0213, 0x09021324, 0x02132416,
+  0x13241509, 0x24150802, 0x15080213, 0x08021324, 0x02132414, 0x14231507,
+  0x23140702, 0x15060214, 0x06021423, 0x02142315, 0x14231406, 0x22150502,
+  0x14050215, 0x05021522, 0x02152214, 0x16211405, 0x21140402, 0x14040215,
+  0x04021521, 0x02162014, 0x16201304, 0x20140302, 0x14030216, 0x0302161f,
+  0x02161f14, 0x171e1303, 0x1e130302, 0x13030216, 0x0202171d, 0x02171d14,
+  0x161d1302, 0x1c130202, 0x13020217, 0x0202161c, 0x02171b13, 0x171b1302,
+  0x1a130202, 0x13020217, 0x0202171a, 0x02171912, 0x18181202, 0x18120202,
+  0x12020217, 0x02021817, 0x02171712, 0x18161202, 0x15120202, 0x2b020118,
+  0x012a0201, 0x02012902, 0x28020129, 0x01270201, 0x02012702, 0x24030126,
+  0x01230301, 0x04012203, 0x1f040120, 0x011d0501, 0x06011b05, 0x11070116,
+  0x010d0801, 0x0f010b0a, 0x00000002, 0x01071a01, 0x16010b18, 0x1015010e,
+  0x01111401, 0x13011214, 0x14120113, 0x01141101, 0x0f011510, 0x160e0115,
+  0x01170d01, 0x0901190b, 0x1e07011c, 0x011f0601, 0x04012005, 0x20040121,
+  0x01210301, 0x04012003, 0x1e04011f, 0x011d0501, 0x09011a07, 0x150b0118,
+  0x01150b01, 0x0a01160a, 0x150a0115, 0x01140a01, 0x09011509, 0x14090114,
+  0x01140801, 0x08011408, 0x13080113, 0x01140701, 0x07011307, 0x12070113,
+  0x01130601, 0x06011306, 0x12060112, 0x01110601, 0x05011205, 0x11050112,
+  0x01110501, 0x04011104, 0x11040111, 0x01100401, 0x03011004, 0x10030111,
+  0x01100301, 0x03011003, 0x0f03010f, 0x01100201, 0x02010f02, 0x0f02010f,
+  0x010e0201, 0x01010f01, 0x0e01010f, 0x010e0101, 0x01010e01, 0x0d01010d,
+  0x010b0201, 0x00000803, 0x0e1f0100, 0x01141c01, 0x1801171a, 0x1d17011b,
+  0x01201501, 0x13012214, 0x24130124, 0x01261201, 0x10012711, 0x2a0f0128,
+  0x012a0f01, 0x0d012b0e, 0x170d022c, 0x0c021425, 0x02132517, 0x1325170b,
+  0x24160b02, 0x160a0214, 0x0a021424, 0x02132415, 0x1423150a, 0x23140a02,
+  0x140a0213, 0x0b021422, 0x02142112, 0x14210f0c, 0x200c0d02, 0x04110214,
+  0x1e01151f, 0x141e0115, 0x01151d01, 0x1b01151c, 0x151a0115, 0x01161901,
+  0x18011618, 0x15170115, 0x01161601, 0x14011615, 0x16130116, 0x01161201,
+  0x10011611, 0x160f0116, 0x01160e01, 0x0c01160d, 0x160b0116, 0x01160a01,
+  0x0901150a, 0x14080114, 0x01140701, 0x05011406, 0x27040123, 0x01280401,
+  0x02012903, 0x2b02012a, 0x012c0101, 0x01012b01, 0x2b01012b, 0x012b0101,
+  0x03012902, 0x27030128, 0x01260301, 0x03012603, 0x23030124, 0x011e0501,
+  0x00001508, 0x29010000, 0x0c230101, 0x01112001, 0x1a01151d, 0x1c180119,
+  0x011e1701, 0x15012016, 0x22140121, 0x01241201, 0x11012611, 0x26110126,
+  0x01261101, 0x11012611, 0x0e120225, 0x12021323, 0x0214220b, 0x14220713,
+  0x01142101, 0x20011520, 0x151f0115, 0x01161e01, 0x1c01161d, 0x161b0116,
+  0x01171901, 0x17011718, 0x17160117, 0x01161501, 0x13011614, 0x19120116,
+  0x011c1101, 0x10011e10, 0x210f011f, 0x01210f01, 0x0f01220f, 0x220f0122,
+  0x01230f01, 0x14012111, 0x1220011e, 0x01112101, 0x20011121, 0x11200112,
+  0x01121f01, 0x1d01131e, 0x141c0114, 0x01151b01, 0x1801161a, 0x1a150117,
+  0x12050602, 0x2a04011c, 0x012a0301, 0x02012b02, 0x2a01012a, 0x012a0101,
+  0x01012901, 0x26010128, 0x01250101, 0x02012301, 0x1d030120, 0x01190401,
+  0x09011306, 0x0000000a, 0x01062801, 0x23010c25, 0x1122010f, 0x01122101,
+  0x1e01151f, 0x181d0116, 0x01191c01, 0x19011b1a, 0x1d18011c, 0x011e1701,
+  0x15011e16, 0x1f14011f, 0x01201301, 0x11012012, 0x21100120, 0x01210f01,
+  0x0e01220e, 0x230d0122, 0x01230c01, 0x0a01240b, 0x250a0125, 0x02250901,
+  0x141a1108, 0x1a110702, 0x11060214, 0x06021519, 0x02141910, 0x14191005,
+  0x18100402, 0x10030215, 0x03021518, 0x0215170f, 0x15170f02, 0x170e0203,
+  0x02043015, 0x1f160e01, 0x160d0102, 0x0c01021f, 0x00022213, 0x01260f0d,
+  0x01013401, 0x32010133, 0x012f0201, 0x03012b02, 0x25040126, 0x01240501,
+  0x12012207, 0x16120116, 0x01161201, 0x11011611, 0x17100116, 0x01171001,
+  0x0f01170f, 0x170f0117, 0x01170f01, 0x0e01170e, 0x170e0117, 0x01160e01,
+  0x0e01160e, 0x140f0116, 0x01111201, 0x12011012, 0x10120110, 0x01101201,
+  0x13010f12, 0x0b14010d, 0x01091501, 0x00000517, 0x14220100, 0x01211601,
+  0x12012413, 0x26110125, 0x01261101, 0x10012710, 0x27100127, 0x01261001,
+  0x0f01260f, 0x230f0125, 0x01210e01, 0x0d01140e, 0x130d0114, 0x01140c01,
+  0x0b01130c, 0x130b0113, 0x01130a01, 0x0901120a, 0x12090113, 0x02120801,
+  0x02231208, 0x1c120702, 0x1207020f, 0x0601131a, 0x2a060128, 0x012c0501,
+  0x05012d05, 0x2e05012d, 0x012e0501, 0x06012f05, 0x2d07012e, 0x012e0601,
+  0x06012e06, 0x1107022e, 0x0802181c, 0x01171d0a, 0x1d01171d, 0x161d0117,
+  0x01161d01, 0x1c01171c, 0x171b0116, 0x01171b01, 0x1901171a, 0x19180118,
+  0x02191701, 0x1b150a04, 0x012d0201, 0x01012c02, 0x2c01012d, 0x012c0001,
+  0x00012b00, 0x2801012a, 0x01270101, 0x02012501, 0x20030123, 0x011d0401,
+  0x09011906, 0x080f0113, 0x00000000, 0x04290100, 0x010a2601, 0x22010d24,
+  0x1120010f, 0x01131e01, 0x1b01151d, 0x1a1a0118, 0x011c1801, 0x16011d17,
+  0x1c15011d, 0x011b1401, 0x12011a13, 0x18110119, 0x01171001, 0x0f01170f,
+  0x160e0116, 0x01150d01, 0x0c01140d, 0x150b0114, 0x01140b01, 0x0a01140a,
+  0x13090113, 0x01130901, 0x08011308, 0x13070112, 0x1d120702, 0x1306020a,
+  0x06020e1b, 0x01111912, 0x05012506, 0x28050127, 0x01290501, 0x04012a04,
+  0x2b04012b, 0x012b0401, 0x03012d03, 0x1a03022d, 0x0302121e, 0x02121e18,
+  0x121e1802, 0x1e170202, 0x16020212, 0x0202121e, 0x02111e16, 0x111e1502,
+  0x1d140202, 0x14020212, 0x0202121d, 0x02131c14, 0x121c1302, 0x1b130202,
+  0x13020213, 0x0202131b, 0x02131a13, 0x14191302, 0x012a0201, 0x03012a02,
+  0x28030128, 0x01270301, 0x04012504, 0x22050124, 0x01200601, 0x08011e07,
+  0x170a011b, 0x01130c01, 0x00000c0f, 0x01052b01, 0x1f010d25, 0x1c180114,
+  0x01270d01, 0x0901290b, 0x2e08012b, 0x012f0801, 0x07013107, 0x33060132,
+  0x01330601, 0x06013306, 0x31070132, 0x01300701, 0x1d012d09, 0x191c0119,
+  0x01181c01, 0x1a01181b, 0x181a0118, 0x01181901, 0x18011818, 0x18170117,
+  0x01181601, 0x15011716, 0x17150118, 0x01171401, 0x13011714, 0x16130117,
+  0x01171201, 0x11011612, 0x16110116, 0x01161001, 0x0f011610, 0x150f0116,
+  0x01150f01, 0x0e01150e, 0x150d0114, 0x01140d01, 0x0c01150c, 0x140b0114,
+  0x01140b01, 0x0a01140a, 0x14090114, 0x01130901, 0x07011408, 0x13070114,
+  0x01140601, 0x05011306, 0x13050113, 0x01130401, 0x02011303, 0x14010114,
+  0x01130101, 0x00011201, 0x12000113, 0x01100101, 0x02010f01, 0x0904010d,
+  0x00000000, 0x0c210100, 0x01111e01, 0x1a01141c, 0x1a180117, 0x011f1701,
+  0x14012215, 0x26130124, 0x01281201, 0x11012911, 0x2b10012a, 0x012c0f01,
+  0x0e012c0f, 0x160e022d, 0x0e021427, 0x02132815, 0x1229150d, 0x29140d02,
+  0x140d0212, 0x0d02112a, 0x02102a13, 0x1129130d, 0x28130d02, 0x120d0212,
+  0x0d021227, 0x02122712, 0x1226120d, 0x25120d02, 0x120e0213, 0x0e021324,
+  0x01142212, 0x0f01270f, 0x24100126, 0x01231001, 0x12012111, 0x1d13011f,
+  0x011c1301, 0x10011c11, 0x1e0e011c, 0x01210c01, 0x0a01230b, 0x26090125,
+  0x01280801, 0x06012907, 0x2c05012b, 0x1d160402, 0x14040214, 0x0302131e,
+  0x02131f14, 0x131f1303, 0x20120302, 0x13020212, 0x02021220, 0x02122013,
+  0x12201302, 0x20140202, 0x15020211, 0x0102121f, 0x01131e18, 0x01013001,
+  0x2f010130, 0x012e0201, 0x02012d02, 0x2c02012d, 0x012b0201, 0x03012903,
+  0x27040129, 0x01250401, 0x06012305, 0x1e070121, 0x011a0901, 0x0f01160b,
+  0x0000000e, 0x19010000, 0x1616010f, 0x011b1401, 0x10011e12, 0x220f0121,
+  0x01230e01, 0x0c01240d, 0x260b0125, 0x01270a01, 0x08012909, 0x2d07012b,
+  0x022d0701, 0x13211706, 0x22160502, 0x15050212, 0x04021222, 0x02122215,
+  0x13211404, 0x21150302, 0x14030213, 0x02021321, 0x02142014, 0x13201402,
+  0x1f140202, 0x15010214, 0x0102141f, 0x02151e15, 0x151d1501, 0x1b160102,
+  0x31010117, 0x01310101, 0x01013001, 0x30010130, 0x012f0101, 0x01012f01,
+  0x2d02012f, 0x012d0201, 0x03012d02, 0x2a04012b, 0x01280501, 0x07012706,
+  0x24080125, 0x02220a01, 0x1516070d, 0x01161501, 0x14011515, 0x16130115,
+  0x01151301, 0x11011612, 0x16110116, 0x01161001, 0x0f01160f, 0x160e0116,
+  0x01150e01, 0x0d01160d, 0x150c0115, 0x01150b01, 0x0a01140b, 0x140a0115,
+  0x01130a01, 0x0a01120a, 0x100a0111, 0x010e0b01, 0x0e010b0c, 0x00000007,
+};
+constexpr uint32_t kNativeGlyphSpanData[] = {
+  0x810c0300, 0x8113060d, 0x0b810a02, 0x0c09020a, 0x08028216, 0x02811911,
+  0x811a1307, 0x07810602, 0x15060114, 0x06810505, 0x1181100a, 0x03811b0a,
+  0x09120b05, 0x0405811b, 0x0f0a0581, 0x1b091281, 0x0a040481, 0x0912810e,
+  0x0305811b, 0x110a0481, 0x1b091281, 0x0a030581, 0x8111810d, 0x811b0912,
+  0x0d0a0305, 0x12811181, 0x04811b09, 0x0a038102, 0x811b0a11, 0x03810206,
+  0x10810c09, 0x1b0a1181, 0x0a020381, 0x0a118110, 0x100a0202, 0x8101050b,
+  0x810b0902, 0x0b10810f, 0x02810105, 0x0f810b09, 0x04811a0b, 0x09028101,
+  0x0b0f810e, 0x0e0a0103, 0x040b0f81, 0x810a0901, 0x81190b0e, 0x0a090104,
+  0x0e810d81, 0x0901040b, 0x0b0d810a, 0x01028118, 0x040c0c09, 0x810b0901,
+  0x81170b0c, 0x0b090102, 0x1501020c, 0x01018116, 0x14010215, 0x01028115,
+  0x01811413, 0x01021301, 0x01110281, 0x02031002, 0x100d0381, 0x09030281,
+  0x0403820c, 0x0a050581, 0x82070181, 0x860d0100, 0x0c810b03, 0x02811408,
+  0x0b0a8109, 0x09810805, 0x1681150c, 0x02811802, 0x12088107, 0x07810603,
+  0x01811a13, 0x05031506, 0x1b150681, 0x0b050481, 0x09128210, 0x0405811b,
+  0x0f0a0581, 0x1b091281, 0x0b040381, 0x811b0912, 0x0e0a0404, 0x1b091281,
+  0x81030581, 0x81110a04, 0x811b0912, 0x0d0a0305, 0x12811181, 0x04811b09,
+  0x0a038102, 0x811b0a11, 0x03810205, 0x11810c09, 0x05811b0a, 0x810c0a02,
+  0x0a118110, 0x0202811b, 0x040b100a, 0x09028101, 0x0b10810b, 0x02810106,
+  0x0f810b09, 0x1a0a1081, 0x81010481, 0x0b0f0902, 0x0103811a, 0x0f810e0a,
+  0x0901040b, 0x0b0e810a, 0x01048119, 0x0d810a09, 0x030b0e81, 0x810a0901,
+  0x01050c0d, 0x0c810a09, 0x180b0d81, 0x09010281, 0x01040c0c, 0x0c810b09,
+  0x0381170b, 0x810a0901, 0x01020c0b, 0x02811615, 0x81151401, 0x02140101,
+  0x81141301, 0x02810103, 0x03811311, 0x10028101, 0x02028112, 0x0381110f,
+  0x0b038102, 0x0303820e, 0x0b070481, 0x82050381, 0x82090207, 0x0d810c03,
+  0x03811104, 0x070b810a, 0x0a018112, 0x0a090109, 0x120a0802, 0x0b070181,
+  0x06810502, 0x8103030c, 0x81120e04, 0x03810203, 0x0281120f, 0x81121002,
+  0x02810102, 0x0f020210, 0x02028111, 0x030e0381, 0x0b058104, 0x05018110,
+  0x0a05020b, 0x0402810f, 0x030a0581, 0x09058104, 0x0401810e, 0x0904020a,
+  0x0303810d, 0x0d090481, 0x81030281, 0x03020904, 0x01810c09, 0x02030903,
+  0x0b080381, 0x81020381, 0x810b0803, 0x02090201, 0x810a0802, 0x02080201,
+  0x08028101, 0x02810103, 0x02810907, 0x07028101, 0x02080101, 0x81080701,
+  0x01810002, 0x81000207, 0x00030701, 0x07060181, 0x81000281, 0x01020601,
+  0x00810605, 0x02840d01, 0x060c810b, 0x12080a02, 0x81090281, 0x0802090a,
+  0x030a0981, 0x0a088107, 0x06028112, 0x030b0781, 0x0d058104, 0x03028112,
+  0x0281120f, 0x81121002, 0x02810102, 0x81010310, 0x81110f02, 0x030f0201,
+  0x0c048103, 0x05028110, 0x010a0681, 0x05020b05, 0x02810f0a, 0x0a058104,
+  0x0e0a0402, 0x0a040181, 0x04810303, 0x02810d09, 0x09048103, 0x0c090302,
+  0x09030281, 0x0301810c, 0x81020309, 0x810b0803, 0x03810202, 0x08020208,
+  0x0202810a, 0x02810a08, 0x08028101, 0x02810103, 0x03810907, 0x07028101,
+  0x01018109, 0x07010208, 0x01028108, 0x02810807, 0x07018100, 0x01810003,
+  0x03810706, 0x06018100, 0x00028107, 0x01060181, 0x00008501, 0x03880f01,
+  0x0a0e810d, 0x0b028118, 0x010e0c81, 0x0903110a, 0x1b110a81, 0x81080281,
+  0x07031309, 0x1c140881, 0x15070281, 0x0603811c, 0x1c150781, 0x81050481,
+  0x82110b06, 0x05030913, 0x1281100b, 0x0a05050a, 0x8111810f, 0x811b0912,
+  0x110a0502, 0x8105060a, 0x810e0806, 0x09118110, 0x0605811a, 0x0b030882,
+  0x10810f82, 0x0a0f020a, 0x0e018119, 0x0b0d010b, 0x170b0c02, 0x810b0381,
+  0x81160a0c, 0x0b810a02, 0x8109020b, 0x08020b0a, 0x020b0981, 0x0b088107,
+  0x07810602, 0x8105020b, 0x05010b06, 0x0a04020b, 0x0302810e, 0x02810d0a,
+  0x82141202, 0x02810102, 0x15010214, 0x00038116, 0x16150181, 0x81000281,
+  0x00021501, 0x03150181, 0x13028101, 0x01038115, 0x14120281, 0x81010381,
+  0x81131102, 0x04820203, 0x00830f0b, 0x810e0300, 0x8117080f, 0x0d810c03,
+  0x0381190c, 0x0f0b810a, 0x0903811a, 0x1b110a81, 0x13090181, 0x03140801,
+  0x14088107, 0x0603811c, 0x1c150781, 0x0c060481, 0x09138112, 0x0503811c,
+  0x120b0681, 0x0b05020a, 0x05050a12, 0x11810f0a, 0x1b091281, 0x0a050381,
+  0x0a118110, 0x0d070604, 0x1a0a1081, 0x83080281, 0x0e020b0f, 0x030a0f81,
+  0x0a0e810d, 0x0c038118, 0x170a0d81, 0x0b0c0181, 0x020b0b01, 0x81150b0a,
+  0x140b0902, 0x0b080281, 0x07028113, 0x0281120b, 0x81110b06, 0x100b0502,
+  0x81040381, 0x810f0a05, 0x04810302, 0x8102030a, 0x870d0a03, 0x01140201,
+  0x00031501, 0x16150181, 0x81000281, 0x00021501, 0x02150181, 0x81151401,
+  0x02810102, 0x81010313, 0x81141202, 0x02810103, 0x01811210, 0x00008b04,
+  0x83110300, 0x83150114, 0x10820e02, 0x810c0209, 0x0b010d0d, 0x110a0110,
+  0x09810803, 0x03811b12, 0x12098108, 0x0803811b, 0x1b120981, 0x81080481,
+  0x81100709, 0x09030a11, 0x11820d04, 0x0a10020a, 0x0f03811a, 0x1a0a1081,
+  0x810e0281, 0x0d020b0f, 0x010b0e81, 0x0b010c0c, 0x0b0a020c, 0x09028115,
+  0x0181150c, 0x07020f08, 0x03100881, 0x10088107, 0x07038118, 0x18100881,
+  0x81070281, 0x0a021108, 0x02091086, 0x08118110, 0x02091001, 0x8118090f,
+  0x180a0e02, 0x0b0d0181, 0x0c820a03, 0x0481170b, 0x03038102, 0x0e098306,
+  0x16150102, 0x81000281, 0x00031501, 0x15140181, 0x81000381, 0x81141301,
+  0x01810003, 0x02811211, 0x81100f01, 0x03810203, 0x01820d0a, 0x00008604,
+  0x81140100, 0x11811003, 0x03811807, 0x0b0e810d, 0x0b038119, 0x1a0e0c81,
+  0x810a0281, 0x0902100b, 0x03110a81, 0x12098108, 0x0803811b, 0x1b120981,
+  0x81080381, 0x811b1209, 0x0f060903, 0x030a1181, 0x81108409, 0x10020a11,
+  0x01811a0a, 0x0e020b0f, 0x0381190b, 0x0b0d810c, 0x0b038118, 0x170b0c81,
+  0x810a0381, 0x81160b0b, 0x0a810902, 0x8108030b, 0x81160d09, 0x170f0802,
+  0x81070281, 0x07031008, 0x18100881, 0x81070281, 0x08021108, 0x010f0a82,
+  0x10010910, 0x810f0309, 0x81180810, 0x0f810e03, 0x02811809, 0x0a0e810d,
+  0x0d810c02, 0x8303040b, 0x0d0a8109, 0x01028117, 0x02150281, 0x81161501,
+  0x01810003, 0x02811514, 0x14018100, 0x01810003, 0x03811312, 0x10018100,
+  0x01038111, 0x0f0d0281, 0x81030381, 0x830a0604, 0x00000000, 0x14821203,
+  0x02821703, 0x81190811, 0x10810f02, 0x810e030a, 0x811a0b0f, 0x0e810d03,
+  0x02811a0c, 0x811a0e0c, 0x1a0f0b02, 0x100a0181, 0x19100902, 0x10080281,
+  0x07018118, 0x81060211, 0x05031107, 0x17110681, 0x12050281, 0x04018117,
+  0x09030313, 0x0a0d810c, 0x03810205, 0x0d810c08, 0x04811609, 0x08028101,
+  0x81160a0c, 0x0b080103, 0x060a0c81, 0x07018100, 0x82160b0b, 0x811a0218,
+  0x01810005, 0x0b820906, 0x02811a0f, 0x811a1a00, 0x01810002, 0x16010219,
+  0x01038217, 0x14120281, 0x81020381, 0x81141103, 0x020b0901, 0x0b098108,
+  0x130b0802, 0x81070381, 0x81130b08, 0x08810702, 0x0c07010b, 0x120b0702,
+  0x0b070181, 0x020b0701, 0x81110809, 0x01080901, 0x09020809, 0x03060a81,
+  0x030b810a, 0x0000810e, 0x02831401, 0x07128111, 0x11811003, 0x01811908,
+  0x0e020b0f, 0x03811a0c, 0x0d0d810c, 0x0b03811a, 0x1a0e0c81, 0x810a0281,
+  0x09030f0b, 0x190f0a81, 0x81080281, 0x07031009, 0x18100881, 0x11070181,
+  0x02120601, 0x81171205, 0x05810403, 0x04811712, 0x08048103, 0x0a0d810c,
+  0x0b080303, 0x040a0d82, 0x810a0802, 0x81160a0c, 0x02810106, 0x0b810907,
+  0x160a0c81, 0x07010581, 0x810b8108, 0x82180a0c, 0x01810005, 0x0b810706,
+  0x04811a0f, 0x83060600, 0x811a1109, 0x01810003, 0x03811a19, 0x18018100,
+  0x01028119, 0x02821514, 0x81141202, 0x09860303, 0x0181140b, 0x08030b09,
+  0x130a0981, 0x0b080281, 0x07028113, 0x020b0881, 0x0b088107, 0x120b0702,
+  0x0b070281, 0x07018112, 0x8207030b, 0x81110809, 0x01080901, 0x09020809,
+  0x02811007, 0x810f050a, 0x00830b01, 0x038a1101, 0x100b8209, 0x0803811b,
+  0x1b120981, 0x13080281, 0x0802811b, 0x02811b13, 0x13088107, 0x08810703,
+  0x02811911, 0x87110a07, 0x07810603, 0x01811009, 0x05020a06, 0x02090681,
+  0x810e0905, 0x05810402, 0x09040209, 0x03058211, 0x0c080481, 0x16080e82,
+  0x14030281, 0x02028117, 0x03160381, 0x16038102, 0x02028119, 0x01170381,
+  0x03011703, 0x09030317, 0x0c0e820c, 0x0e850403, 0x020b0f81, 0x0b0f810e,
+  0x190b0e02, 0x810d0281, 0x0d010b0e, 0x0c0c020c, 0x02038118, 0x0b810a85,
+  0x1601020d, 0x00028117, 0x01160181, 0x00011600, 0x81000315, 0x81131201,
+  0x12110102, 0x81020381, 0x81100d03, 0x07830403, 0x00820c05, 0x860b0300,
+  0x811b0a11, 0x1b120902, 0x81080381, 0x811b1209, 0x1b130802, 0x13080281,
+  0x0703811b, 0x1a120881, 0x11070281, 0x06028118, 0x010a0781, 0x05030a06,
+  0x0f090681, 0x0a050181, 0x05810402, 0x09040209, 0x0305810d, 0x0e090481,
+  0x13021183, 0x14030183, 0x03810203, 0x02811815, 0x16038102, 0x03810203,
+  0x02811916, 0x17038102, 0x01170301, 0x03041703, 0x09050481, 0x020c0e83,
+  0x0b0f810e, 0x0f810e03, 0x0281190a, 0x81190b0e, 0x0e810d02, 0x810c030b,
+  0x81180b0d, 0x0c810b03, 0x0481180c, 0x05028101, 0x0e0a8307, 0x01810002,
+  0x16000216, 0x00028116, 0x03811515, 0x13018100, 0x00028114, 0x03120181,
+  0x0f028101, 0x03038111, 0x0e0a0481, 0x85070182, 0x00000000, 0x03831401,
+  0x05138112, 0x10038118, 0x18071181, 0x810e0281, 0x0d010a0f, 0x810b020d,
+  0x0a030e0c, 0x190e0b81, 0x81090381, 0x81170d0a, 0x09810803, 0x0381150c,
+  0x0b088107, 0x07028113, 0x0281120b, 0x0a078106, 0x06810502, 0x0a05020a,
+  0x0403810f, 0x0e090581, 0x0a040181, 0x04810302, 0x09030409, 0x060e820c,
+  0x03028114, 0x03811512, 0x13038102, 0x02018116, 0x15020215, 0x01028117,
+  0x02160281, 0x16028101, 0x0d0c0103, 0x03090f81, 0x810c0b01, 0x0103090f,
+  0x17080f0b, 0x0a010481, 0x080f810e, 0x01038117, 0x17090e0a, 0x09010481,
+  0x810d810a, 0x0105090e, 0x0c810a09, 0x16090d81, 0x15010181, 0x02810103,
+  0x02811513, 0x13028101, 0x01120201, 0x04031003, 0x110c0581, 0x81060381,
+  0x820e0707, 0x81130300, 0x81170314, 0x12811103, 0x03811806, 0x0810810f,
+  0x0d038118, 0x190b0e81, 0x810c0281, 0x0b010d0d, 0x0e0a020f, 0x09028118,
+  0x0281160d, 0x81140c08, 0x08810702, 0x8106030b, 0x81110a07, 0x100a0602,
+  0x81050281, 0x05010a06, 0x8104020a, 0x04020905, 0x03810d09, 0x09048103,
+  0x0303860e, 0x0d810c09, 0x81020208, 0x02021303, 0x02140381, 0x81171502,
+  0x17150202, 0x81010281, 0x01041602, 0x0e0c0281, 0x02090f81, 0x090f0c01,
+  0x0f0b0102, 0x0a010509, 0x810e810b, 0x8117080f, 0x0e0a0103, 0x04811709,
+  0x810a0901, 0x090e810d, 0x0a090103, 0x040a0d81, 0x810b0a01, 0x81160a0c,
+  0x03150101, 0x13028101, 0x02028115, 0x03811412, 0x10038102, 0x03038113,
+  0x120e0481, 0x81050381, 0x81100a06, 0x00870701, 0x15831203, 0x02811803,
+  0x0b0f830c, 0x06810502, 0x16040214, 0x0302811a, 0x02180481, 0x811c1903,
+  0x1c190302, 0x19030181, 0x04810303, 0x01811b17, 0x0d020d0e, 0x010c0e81,
+  0x0c020c0d, 0x0381180c, 0x0b0c810b, 0x0b018117, 0x810a030c, 0x81160b0b,
+  0x150b0a02, 0x81090281, 0x09020b0a, 0x0381140b, 0x0a098108, 0x08018113,
+  0x8107030b, 0x81120a08, 0x020b0701, 0x0a078106, 0x100a0602, 0x81050281,
+  0x05020a06, 0x02810f0a, 0x0a058104, 0x030a0401, 0x09048103, 0x0301810d,
+  0x8102020a, 0x01030903, 0x0b090281, 0x81000281, 0x00020a01, 0x02090181,
+  0x81090900, 0x01810003, 0x03810807, 0x05028101, 0x00008107, 0x03831501,
+  0x0712830f, 0x06028119, 0x020e0c86, 0x15058104, 0x1b170402, 0x81030381,
+  0x811c1804, 0x1c190302, 0x19030281, 0x0302811c, 0x02180481, 0x0d0e8a04,
+  0x1a0c0e02, 0x0c0d0281, 0x0c028119, 0x010c0d81, 0x0b020c0c, 0x0381170c,
+  0x0b0b810a, 0x0a018116, 0x8109030c, 0x81150b0a, 0x140b0902, 0x81080281,
+  0x08020b09, 0x0281130b, 0x0b088107, 0x08810702, 0x0a07020a, 0x06028111,
+  0x020a0781, 0x81100a06, 0x06810503, 0x01810f09, 0x04030a05, 0x0e090581,
+  0x81030281, 0x03010a04, 0x8102030a, 0x810c0903, 0x010a0201, 0x00030a01,
+  0x0a090181, 0x09000281, 0x00018109, 0x81000209, 0x02010701, 0x00000085,
+  0x02871001, 0x090f810e, 0x0d810c02, 0x810a030c, 0x811b100b, 0x0a810903,
+  0x02811c12, 0x14098108, 0x1d150802, 0x81070381, 0x811d1508, 0x120b0704,
+  0x1d0a1381, 0x81060581, 0x81110a07, 0x811d0914, 0x07810606, 0x14811009,
+  0x1d081581, 0x81060481, 0x81140907, 0x06040815, 0x13090781, 0x05091481,
+  0x08078106, 0x0913810f, 0x0603811c, 0x12090781, 0x0907030a, 0x0a118110,
+  0x08810703, 0x02811a12, 0x81191108, 0x180f0902, 0x81080381, 0x81170e09,
+  0x08810702, 0x8105020e, 0x04031106, 0x17120581, 0x81030281, 0x02031404,
+  0x18150381, 0x0a020581, 0x810e810c, 0x8118090f, 0x02810105, 0x0f810b09,
+  0x03091081, 0x810a0901, 0x01030910, 0x10810a09, 0x0a010509, 0x810f810b,
+  0x81180810, 0x01810005, 0x0f820d0c, 0x03811809, 0x17018100, 0x01018118,
+  0x16010217, 0x01028117, 0x02811615, 0x14028101, 0x14120202, 0x10030281,
+  0x04038113, 0x110c0581, 0x88070181, 0x810f0300, 0x81170710, 0x0e810d03,
+  0x0381180a, 0x0d0c810b, 0x0a018219, 0x14090112, 0x09810803, 0x03811d14,
+  0x15088107, 0x0702811d, 0x04811d16, 0x81130b07, 0x811d0914, 0x07810605,
+  0x1581140a, 0x05811d08, 0x09078106, 0x08158110, 0x0603811d, 0x14090781,
+  0x81060609, 0x810f0807, 0x08148113, 0x0605811c, 0x0f080781, 0x13811281,
+  0x09070409, 0x09128111, 0x0702811b, 0x01130881, 0x08021208, 0x02100981,
+  0x0e0a8109, 0x160e0802, 0x81060381, 0x81160f07, 0x17120502, 0x14040181,
+  0x18150302, 0x0b020481, 0x0a0e810d, 0x01038118, 0x0f0a0281, 0x8101040a,
+  0x810f0902, 0x01030910, 0x10810a09, 0x0a010209, 0x00050910, 0x0c0b0181,
+  0x18090f81, 0x81000381, 0x81181701, 0x01810002, 0x16010217, 0x01018117,
+  0x81010216, 0x02021402, 0x02811513, 0x11038102, 0x04810303, 0x0381120e,
+  0x08078205, 0x0000820f, 0x810b0300, 0x8214080c, 0x0a810902, 0x8107030e,
+  0x81181008, 0x07810603, 0x03811811, 0x12068105, 0x04028118, 0x02140581,
+  0x16048103, 0x0f0c0303, 0x040a1081, 0x0a038102, 0x0911810d, 0x0c0a0204,
+  0x11811081, 0x81010409, 0x81100a02, 0x01020911, 0x050a100a, 0x0a018100,
+  0x0910810f, 0x00058119, 0x0e0a0181, 0x190a0f81, 0x81000481, 0x810c0b01,
+  0x00020c0d, 0x03180181, 0x17018100, 0x00028118, 0x02170181, 0x17018100,
+  0x17160102, 0x81010281, 0x02031502, 0x16130381, 0x81030281, 0x05041204,
+  0x0a040681, 0x030b0b81, 0x0a0b810a, 0x09038115, 0x140a0a81, 0x0b090181,
+  0x09810803, 0x0281130a, 0x0b088107, 0x120b0702, 0x81060381, 0x81110a07,
+  0x020b0601, 0x0a068105, 0x0f0a0502, 0x09050281, 0x0502810e, 0x03810d08,
+  0x06068105, 0x0701810c, 0x00000084, 0x880c0100, 0x0b810a03, 0x0382160b,
+  0x0f098108, 0x07028118, 0x02811811, 0x81181206, 0x18130502, 0x15040281,
+  0x03028119, 0x05160481, 0x0b038102, 0x8110810e, 0x02020911, 0x0409110b,
+  0x0a028101, 0x09118110, 0x0b0a0103, 0x040a1081, 0x810f0a01, 0x81190910,
+  0x01810004, 0x190a0f0a, 0x81000581, 0x810b0a01, 0x0b0e810d, 0x01810002,
+  0x81000318, 0x81181701, 0x01810003, 0x02811817, 0x17018100, 0x17160102,
+  0x16010281, 0x02018117, 0x13030215, 0x04028116, 0x03110581, 0x0a0b8506,
+  0x0a018115, 0x8109030b, 0x81140a0a, 0x09810802, 0x0b08020b, 0x07038113,
+  0x120a0881, 0x0b070181, 0x07810603, 0x0381110a, 0x0a068105, 0x05028110,
+  0x01810f0a, 0x05010a05, 0x08050109, 0x07810603, 0x00810b04,
+};
 constexpr uint8_t kFirstGlyph = 48;
 constexpr uint8_t kLastGlyph = 57;
 constexpr Glyph DRAM_ATTR kGlyphs[] = {
-  {57, 79, 0},
-  {38, 79, 158},
-  {58, 79, 316},
-  {56, 80, 474},
-  {55, 81, 634},
-  {57, 76, 796},
-  {53, 76, 948},
-  {58, 77, 1100},
-  {61, 79, 1254},
-  {53, 78, 1412},
+  {57, 79, 0, 0, 321},
+  {38, 79, 158, 324, 235},
+  {58, 79, 316, 560, 259},
+  {56, 80, 474, 820, 242},
+  {55, 81, 634, 1064, 271},
+  {57, 76, 796, 1336, 234},
+  {53, 76, 948, 1572, 262},
+  {58, 77, 1100, 1836, 229},
+  {61, 79, 1254, 2068, 285},
+  {53, 78, 1412, 2356, 258},
+};
+constexpr NativeGlyph DRAM_ATTR kNativeGlyphs[][2] = {
+  {{0, 276}, {276, 296}},
+  {{572, 200}, {772, 206}},
+  {{980, 232}, {1212, 226}},
+  {{1440, 214}, {1656, 233}},
+  {{1892, 227}, {2120, 243}},
+  {{2364, 200}, {2564, 213}},
+  {{2780, 224}, {3004, 227}},
+  {{3232, 195}, {3428, 193}},
+  {{3624, 276}, {3900, 258}},
+  {{4160, 241}, {4404, 224}},
 };
@@ -0,0 +1,37 @@
+#include "frame_scheduler.h"
+
+#include <esp_attr.h>
+#include <freertos/task.h>
+
+#include <algorithm>
+
+FrameScheduler::FrameScheduler() {
+  ResetStats();
+}
+
+bool IRAM_ATTR FrameScheduler::Update(const Inputs& inputs) {
+  if (valid_ && inputs == last_inputs_) {
+    stats_.skipped_frames++;
+    return false;
+  }
+  last_inputs_ = inputs;
+  valid_ = true;
+  stats_.rendered_frames++;
+  return true;
+}
+
+void FrameScheduler::Wait(TickType_t timeout) {
+  TickType_t start = xTaskGetTickCount();
+  ulTaskNotifyTake(pdTRUE, std::max<TickType_t>(timeout, 1));
+  stats_.idle_ticks += xTaskGetTickCount() - start;
+}
+
+uint32_t FrameScheduler::idle_percent() const {
+  TickType_t elapsed = xTaskGetTickCount() - stats_.start_tick;
+  return elapsed ? stats_.idle_ticks * 100 / elapsed : 0;
+}
+
+void FrameScheduler::ResetStats() {
+  stats_ = Stats();
+  stats_.start_tick = xTaskGetTickCount();
+}
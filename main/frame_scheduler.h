@@ -0,0 +1,52 @@
+#pragma once
+
+#include <FreeRTOS.h>
+#include <stdint.h>
+
+// Decides whether a frame needs to be rendered at all. A frame is a function
+// of a few inputs; if none of them changed since the last rendered frame,
+// the screen already shows it, and the main loop can skip both the render
+// and the scan-out and block until the next measurement instead.
+class FrameScheduler {
+ public:
+  // Everything that determines the contents of a frame.
+  struct Inputs {
+    uint32_t display_mm = 0;
+    // Palette fade towards black, 0 to 255.
+    uint8_t fade = 0;
+
+    bool operator==(const Inputs& other) const {
+      return display_mm == other.display_mm && fade == other.fade;
+    }
+  };
+
+  struct Stats {
+    uint32_t rendered_frames = 0;
+    uint32_t skipped_frames = 0;
+    // Time spent in Wait(), out of the time since the stats were reset.
+    TickType_t idle_ticks = 0;
+    TickType_t start_tick = 0;
+  };
+
+  FrameScheduler();
+
+  // Returns whether a frame with |inputs| has to be rendered, and counts it
+  // as rendered or skipped.
+  bool Update(const Inputs& inputs);
+  // Forces the next frame to be rendered, e.g., if the panel was off.
+  void Invalidate() { valid_ = false; }
+
+  // Blocks until the task is notified or |timeout| ticks pass, whichever is
+  // first. Counts as idle time.
+  void Wait(TickType_t timeout);
+
+  const Stats& stats() const { return stats_; }
+  // Percentage of the time since the stats were reset spent in Wait().
+  uint32_t idle_percent() const;
+  void ResetStats();
+
+ private:
+  Inputs last_inputs_;
+  bool valid_ = false;
+  Stats stats_;
+};
@@ -0,0 +1,122 @@
+#include "i2c_transaction.h"
+
+#include <FreeRTOS.h>
+
+#include "register_shadow.h"
+
+// Have the driver check for the device's ACK after every byte written.
+constexpr bool kAckCheck = true;
+
+I2CTransaction::Stats I2CTransaction::stats_;
+
+I2CTransaction::I2CTransaction(uint8_t address, RegisterShadow* shadow)
+    : address_(address), shadow_(shadow), cmd_(i2c_cmd_link_create()) {}
+
+I2CTransaction::~I2CTransaction() {
+  i2c_cmd_link_delete(cmd_);
+}
+
+void I2CTransaction::Start(uint16_t reg, Direction direction) {
+  FlushRead(I2C_MASTER_LAST_NACK);
+  i2c_master_start(cmd_);
+  i2c_master_write_byte(cmd_, (address_ << 1) | I2C_MASTER_WRITE, kAckCheck);
+  i2c_master_write_byte(cmd_, reg >> 8, kAckCheck);
+  i2c_master_write_byte(cmd_, reg & 0xff, kAckCheck);
+  starts_++;
+  bytes_ += 3;
+  if (direction == Direction::kRead) {
+    i2c_master_start(cmd_);
+    i2c_master_write_byte(cmd_, (address_ << 1) | I2C_MASTER_READ, kAckCheck);
+    starts_++;
+    bytes_++;
+  }
+  direction_ = direction;
+}
+
+void I2CTransaction::FlushRead(i2c_ack_type_t ack) {
+  if (!pending_read_size_)
+    return;
+  i2c_master_read(cmd_, pending_read_, pending_read_size_, ack);
+  pending_read_size_ = 0;
+}
+
+void I2CTransaction::Read(uint16_t reg, uint8_t* data, size_t size) {
+  if (shadow_) {
+    if (shadow_->Read(reg, data, size))
+      return;
+    if (shadow_read_count_ < kMaxShadowReads)
+      shadow_reads_[shadow_read_count_++] = {reg, data, size};
+  }
+  if (direction_ == Direction::kRead && reg == next_reg_) {
+    FlushRead(I2C_MASTER_ACK);
+  } else {
+    Start(reg, Direction::kRead);
+  }
+  pending_read_ = data;
+  pending_read_size_ = size;
+  next_reg_ = reg + size;
+  bytes_ += size;
+}
+
+void I2CTransaction::Write(uint16_t reg, const uint8_t* data, size_t size) {
+  if (shadow_ && !shadow_->Write(reg, data, size))
+    return;
+  if (direction_ != Direction::kWrite || reg != next_reg_)
+    Start(reg, Direction::kWrite);
+  for (size_t i = 0; i < size; i++)
+    i2c_master_write_byte(cmd_, data[i], kAckCheck);
+  next_reg_ = reg + size;
+  bytes_ += size;
+}
+
+void I2CTransaction::WriteFrom(uint16_t reg,
+                               const uint8_t* data,
+                               size_t size) {
+  if (direction_ != Direction::kWrite || reg != next_reg_)
+    Start(reg, Direction::kWrite);
+  // The driver keeps the pointer and reads through it when the link runs.
+  i2c_master_write(cmd_, const_cast<uint8_t*>(data), size, kAckCheck);
+  next_reg_ = reg + size;
+  bytes_ += size;
+}
+
+void I2CTransaction::Write16(uint16_t reg, uint16_t value) {
+  uint8_t bytes[] = {static_cast<uint8_t>(value >> 8),
+                     static_cast<uint8_t>(value)};
+  Write(reg, bytes, sizeof(bytes));
+}
+
+void I2CTransaction::Write32(uint16_t reg, uint32_t value) {
+  uint8_t bytes[] = {
+      static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16),
+      static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)};
+  Write(reg, bytes, sizeof(bytes));
+}
+
+bool I2CTransaction::Submit() {
+  if (!starts_)
+    return true;
+  if (!finished_) {
+    FlushRead(I2C_MASTER_LAST_NACK);
+    i2c_master_stop(cmd_);
+    direction_ = Direction::kNone;
+    finished_ = true;
+  }
+  // i2c_master_cmd_begin() walks the link without consuming it.
+  esp_err_t result =
+      i2c_master_cmd_begin(kI2CPort, cmd_, 1000 / portTICK_RATE_MS);
+  stats_.transactions++;
+  stats_.starts += starts_;
+  stats_.bytes += bytes_;
+  if (shadow_) {
+    if (result != ESP_OK) {
+      shadow_->Clear();
+    } else {
+      for (size_t i = 0; i < shadow_read_count_; i++) {
+        const auto& read = shadow_reads_[i];
+        shadow_->Fill(read.reg, read.data, read.size);
+      }
+    }
+  }
+  return result == ESP_OK;
+}
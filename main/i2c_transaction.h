@@ -0,0 +1,99 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "i2c.h"
+
+class RegisterShadow;
+
+// Sends several register accesses to a device with 16 bit register indices,
+// like the VL53L1X, in one command link and one i2c_master_cmd_begin(). The
+// accesses are separated by repeated STARTs instead of a STOP and a START,
+// and an access that continues the previous one, in the same direction from
+// the next register, is merged into it as a burst.
+//
+// The SDK allocates the command link, and a node for every command queued on
+// it, from the heap. A transaction that is repeated, like polling a status
+// register, should be built once and submitted again and again, reading into
+// and writing from the same buffers.
+//
+// With a RegisterShadow, reads of registers it knows are served from it right
+// away and writes that wouldn't change any are dropped.
+class I2CTransaction {
+ public:
+  struct Stats {
+    // Submitted transactions, each ending with a STOP.
+    uint32_t transactions = 0;
+    // START and repeated START conditions.
+    uint32_t starts = 0;
+    // Including the address and register index bytes.
+    uint32_t bytes = 0;
+  };
+
+  explicit I2CTransaction(uint8_t address, RegisterShadow* shadow = nullptr);
+  ~I2CTransaction();
+
+  I2CTransaction(const I2CTransaction&) = delete;
+  I2CTransaction& operator=(const I2CTransaction&) = delete;
+
+  // Reads |size| registers from |reg| on into |data|, which is filled in by
+  // Submit().
+  void Read(uint16_t reg, uint8_t* data, size_t size);
+  // Writes |size| registers from |reg| on. |data| is copied.
+  void Write(uint16_t reg, const uint8_t* data, size_t size);
+  // Like Write(), but |data| isn't copied: it's sent as it is at every
+  // Submit(), and must stay valid as long as the transaction. Bypasses the
+  // shadow.
+  void WriteFrom(uint16_t reg, const uint8_t* data, size_t size);
+  // Multi-byte registers are big endian.
+  void Write8(uint16_t reg, uint8_t value) { Write(reg, &value, 1); }
+  void Write16(uint16_t reg, uint16_t value);
+  void Write32(uint16_t reg, uint32_t value);
+
+  // Sends the accesses. Returns false if the device didn't acknowledge them
+  // or the bus timed out. No accesses can be added afterwards, but the
+  // transaction can be submitted again, without allocating. The shadow learns
+  // the registers read, or forgets everything if the transaction failed.
+  bool Submit();
+
+  static const Stats& stats() { return stats_; }
+
+ private:
+  enum class Direction : uint8_t { kNone, kWrite, kRead };
+
+  // Addresses the device and sends the register index, then readdresses it
+  // for reading if |direction| is kRead.
+  void Start(uint16_t reg, Direction direction);
+  // Queues the pending read, acknowledging its last byte with |ack|; reads
+  // end with a NACK.
+  void FlushRead(i2c_ack_type_t ack);
+
+  // Reads the shadow learns at Submit(); any beyond these it doesn't.
+  static constexpr size_t kMaxShadowReads = 4;
+  struct ShadowRead {
+    uint16_t reg;
+    const uint8_t* data;
+    size_t size;
+  };
+
+  const uint8_t address_;
+  RegisterShadow* const shadow_;
+  ShadowRead shadow_reads_[kMaxShadowReads];
+  size_t shadow_read_count_ = 0;
+  i2c_cmd_handle_t cmd_;
+  Direction direction_ = Direction::kNone;
+  // Whether the STOP has been queued by the first Submit().
+  bool finished_ = false;
+  // The register after the last one accessed.
+  uint16_t next_reg_ = 0;
+  // Whether the last byte is acknowledged depends on whether the next access
+  // continues the read, so the last read is queued late.
+  uint8_t* pending_read_ = nullptr;
+  size_t pending_read_size_ = 0;
+  // Added to the stats at every Submit().
+  uint16_t starts_ = 0;
+  uint16_t bytes_ = 0;
+
+  static Stats stats_;
+};
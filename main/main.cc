@@ -3,101 +3,90 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
+#include "calibration_store.h"
 #include "display.h"
 #include "distance_sensor.h"
 #include "font.h"
+#include "frame_scheduler.h"
 #include "i2c.h"
+#include "i2c_transaction.h"
 #include "spi.h"
-#include "sprites.h"
 #include "util.h"
 #include "rainbow_fx.h"
+#include "register_shadow.h"
+#include "scene.h"
+#include "sensor_task.h"
+#include "sprites.h"
 
-void IRAM_ATTR Render(RainbowFX& rainbow_fx, uint32_t display_mm) {
-  rainbow_fx.Clear();
-  uint32_t bg_offset = display_mm / 8;
-  const auto& bg_sprite = kSprites[4];
-  rainbow_fx.DrawSprite(bg_sprite, 0, bg_offset % (RainbowFX::kHeight / 2));
-  rainbow_fx.DrawSprite(
-      bg_sprite, RainbowFX::kWidth / 2 - bg_sprite.width,
-      bg_offset % (RainbowFX::kHeight / 2) - RainbowFX::kHeight / 2);
+constexpr uint32_t kSensorPeriodMs = 100;
+// The sensor task preempts the render task, but only for the I2C
+// transactions, and mostly while the render task waits for the SPI bus.
+constexpr UBaseType_t kRenderTaskPriority = tskIDLE_PRIORITY + 2;
+constexpr UBaseType_t kSensorTaskPriority = tskIDLE_PRIORITY + 3;
+// The render task needs as much as the SDK's main task. The sensor task only
+// runs the I2C transactions: the render task writes the calibration to flash
+// for it. The sensor stats report its high water mark, to check this against.
+constexpr uint32_t kRenderTaskStackDepth = 3584;
+constexpr uint32_t kSensorTaskStackDepth = 2048;
+// Whether app_main() times the display transport and full frames before
+// starting the tasks.
+constexpr bool kBenchmarkAtStartup = false;
 
-  const int kMaxHeightMM = 4000;
-  int sprite = 0;
-  for (int h = 0; h < kMaxHeightMM; h += 150) {
-    int y = (static_cast<int>(display_mm) - h) / 2;
-    int x = 24 + h / 16 % 64;
-    if (y < -RainbowFX::kHeight)
-      break;
-    if (sprite % 7 == 0) {
-      rainbow_fx.DrawSprite<RainbowFX::BlendDrawTraits1X>(kSprites[sprite % 5],
-                                                          x * 2, y);
-    } else {
-      rainbow_fx.DrawSprite<RainbowFX::BlendDrawTraits>(kSprites[sprite % 4], x,
-                                                        y);
-    }
-    sprite++;
-  }
+// Owned by the render task.
+struct RenderContext {
+  std::unique_ptr<Display> display;
+  std::unique_ptr<RainbowFX> rainbow_fx;
+  std::unique_ptr<SensorTask> sensor_task;
+  // When DistanceSensor::Create() was called.
+  TickType_t sensor_created = 0;
+};
 
-  char buf[16];
-  itoa(display_mm / 10, buf, 10);
+static void IRAM_ATTR RenderTask(void* arg) {
+  auto* context = static_cast<RenderContext*>(arg);
+  auto& display = context->display;
+  auto& rainbow_fx = context->rainbow_fx;
+  auto& measurements = context->sensor_task->queue();
 
-  uint16_t w, h;
-  rainbow_fx.MeasureText(buf, w, h);
-  // rainbow_fx->Clear();
-  int x = RainbowFX::kWidth / 2 - w / 2;
-  int y = RainbowFX::kHeight / 2 - h / 2;
-  for (auto c : buf) {
-    if (!c)
-      break;
-    auto glyph = rainbow_fx.DrawGlyph(c, x, y);
-    if (!glyph)
-      break;
-    x += glyph->width;
-  }
-}
-
-extern "C" void IRAM_ATTR app_main() {
-  SetupI2C();
-  SetupSPI();
-
-  auto display = std::unique_ptr<Display>(new Display());
-  auto distance_sensor = DistanceSensor::Create();
-
-  auto rainbow_fx = std::unique_ptr<RainbowFX>(new RainbowFX());
-#if 0
-  Benchmark([&]() IRAM_ATTR {
-    rainbow_fx->BeginRender();
-    display->Render([&](uint32_t* pixels)
-                        IRAM_ATTR { rainbow_fx->Render(pixels); });
-  });
-#endif
-  printf("heap free: %d\n", esp_get_free_heap_size());
-  esp_set_cpu_freq(ESP_CPU_FREQ_160M);
-
-  distance_sensor->Start(100);
   uint32_t frame = 0;
   uint32_t distance_mm = 0;
   uint32_t display_mm = 0;
   uint32_t stable_mm = 0;
-  int stable_count = 0;
-  int fail_count = 0;
-  int awake_count = 0;
   bool sleeping = false;
-  constexpr int kSleepThresholdFrames = 60 * 5;
-  constexpr int kFadeFrames = 60;
-  constexpr int kMaxWakeTimeFrames = 60 * 30;
+  bool fading = false;
+  Display::ScanoutStats scanout_totals;
+  FrameScheduler scheduler;
+  FrameScheduler::Inputs inputs;
+  // Skipped frames take no time, so the timeouts are in ticks rather than
+  // frames.
+  constexpr TickType_t kSleepThresholdTicks = 5000 / portTICK_PERIOD_MS;
+  constexpr TickType_t kFadeTicks = 1000 / portTICK_PERIOD_MS;
+  constexpr int kFadeSteps = 20;
+  constexpr TickType_t kMaxWakeTimeTicks = 30000 / portTICK_PERIOD_MS;
+  constexpr TickType_t kMaxSampleGapTicks = 1000 / portTICK_PERIOD_MS;
+  TickType_t last_sample = xTaskGetTickCount();
+  TickType_t stable_since = last_sample;
+  TickType_t awake_since = last_sample;
+  bool first_sample = true;
 
   while (true) {
-    if (distance_sensor->GetDistanceMM(distance_mm)) {
+    // Only the latest measurement matters.
+    Measurement measurement;
+    while (measurements.Pop(measurement)) {
       WDT_FEED();
-      fail_count = 0;
-    } else {
-      fail_count++;
-      if (fail_count > 32) {
-        printf("Too many failures, rebooting...\n");
-        esp_restart();
+      distance_mm = measurement.distance_mm;
+      last_sample = measurement.tick;
+      if (first_sample) {
+        printf("sensor: first distance %u ms after reset\n",
+               (measurement.tick - context->sensor_created) *
+                   portTICK_PERIOD_MS);
+        first_sample = false;
       }
     }
+    TickType_t now = xTaskGetTickCount();
+    if (now - last_sample > kMaxSampleGapTicks) {
+      printf("Too many failures, rebooting...\n");
+      esp_restart();
+    }
 
     int16_t delta = distance_mm - display_mm;
     if (delta) {
@@ -105,42 +94,156 @@ extern "C" void IRAM_ATTR app_main() {
     } else {
       display_mm = distance_mm;
     }
-    if (std::abs(static_cast<int32_t>(distance_mm) - static_cast<int32_t>(stable_mm)) < 7) {
-      stable_count++;
-    } else {
-      stable_count = 0;
+    if (std::abs(static_cast<int32_t>(distance_mm) - static_cast<int32_t>(stable_mm)) >= 7) {
+      stable_since = now;
       stable_mm = distance_mm;
+      if (fading) {
+        esp_set_cpu_freq(ESP_CPU_FREQ_160M);
+        fading = false;
+        rainbow_fx->FadePalette(0);
+      }
       if (sleeping) {
         esp_set_cpu_freq(ESP_CPU_FREQ_160M);
         sleeping = false;
         display->Enable(true);
-        awake_count = 0;
+        scheduler.Invalidate();
+        scheduler.ResetStats();
+        awake_since = now;
       }
     }
-    if (!sleeping)
-      awake_count++;
-    if (stable_count > kSleepThresholdFrames || awake_count > kMaxWakeTimeFrames) {
+    TickType_t stable_ticks = now - stable_since;
+    inputs.display_mm = display_mm;
+    inputs.fade = 0;
+    if (sleeping || stable_ticks > kSleepThresholdTicks ||
+        now - awake_since > kMaxWakeTimeTicks) {
       if (!sleeping) {
         esp_set_cpu_freq(ESP_CPU_FREQ_80M);
         sleeping = true;
         display->Enable(false);
+        printf("scan-out: %u chunks, %u render stalls, %u transfer stalls\n",
+               scanout_totals.chunks, scanout_totals.render_stalls,
+               scanout_totals.transfer_stalls);
+        const auto& asset_stats = rainbow_fx->asset_cache_stats();
+        printf("asset cache: %u hits, %u misses, %u bytes copied over %u "
+               "frames, %u overflows\n",
+               asset_stats.hits, asset_stats.misses, asset_stats.miss_bytes,
+               frame, asset_stats.overflows);
+        const auto& frame_stats = scheduler.stats();
+        printf("frames: %u rendered, %u skipped, %u%% idle\n",
+               frame_stats.rendered_frames, frame_stats.skipped_frames,
+               scheduler.idle_percent());
+        auto sensor_stats = context->sensor_task->stats();
+        printf("sensor: %u measurements, %u polls, %u dropped, stack high "
+               "water mark %u\n",
+               sensor_stats.measurements, sensor_stats.polls,
+               sensor_stats.dropped, sensor_stats.stack_high_water_mark);
+        const auto& i2c_stats = I2CTransaction::stats();
+        printf("i2c: %u transactions, %u starts, %u bytes\n",
+               i2c_stats.transactions, i2c_stats.starts, i2c_stats.bytes);
+        const auto& shadow_stats = RegisterShadow::stats();
+        printf("register shadow: %u reads and %u writes avoided, %u bytes, "
+               "%u stale\n",
+               shadow_stats.reads_avoided, shadow_stats.writes_avoided,
+               shadow_stats.bytes_avoided, shadow_stats.mismatches);
+        // Should stay put from one sleep to the next.
+        printf("heap free: %u\n", esp_get_free_heap_size());
       }
-    } else if (stable_count > kSleepThresholdFrames - kFadeFrames) {
-      if (stable_count % 3 == 0)
-        rainbow_fx->Fade();
-    } else {
-      Render(*rainbow_fx, display_mm);
+    } else if (stable_ticks > kSleepThresholdTicks - kFadeTicks) {
+      // Fade out by darkening the palette. The scene doesn't change, so
+      // there's little to do and the clock can be dropped.
+      if (!fading) {
+        esp_set_cpu_freq(ESP_CPU_FREQ_80M);
+        fading = true;
+      }
+      int step = (stable_ticks - (kSleepThresholdTicks - kFadeTicks)) *
+                 kFadeSteps / kFadeTicks;
+      inputs.fade = std::min(255, step * 255 / kFadeSteps);
     }
 
     if (sleeping) {
       vTaskDelay(250 / portTICK_PERIOD_MS);
+      continue;
+    }
+    if (!scheduler.Update(inputs)) {
+      // With nothing to draw, writing flash holds no frame up.
+      context->sensor_task->SaveCalibration();
+      // The screen is up to date until the sensor task queues the next
+      // measurement, or the next fade step.
+      TickType_t timeout =
+          fading ? kFadeTicks / kFadeSteps : kMaxSampleGapTicks;
+      scheduler.Wait(timeout);
+      continue;
+    }
+    if (fading) {
+      rainbow_fx->FadePalette(inputs.fade);
     } else {
-      rainbow_fx->BeginRender();
-      display->Render([&](uint32_t* pixels)
-                          IRAM_ATTR { rainbow_fx->Render(pixels); });
+      Render(*rainbow_fx, display_mm);
     }
+    rainbow_fx->BeginRender();
+    display->Execute(rainbow_fx->commands(), rainbow_fx->command_count());
+    display->Render(rainbow_fx->scan_rects(), rainbow_fx->scan_rect_count(),
+                    [&](uint32_t* pixels, size_t count) IRAM_ATTR {
+                      rainbow_fx->Render(pixels, count);
+                    });
+    const auto& stats = display->scanout_stats();
+    scanout_totals.chunks += stats.chunks;
+    scanout_totals.render_stalls += stats.render_stalls;
+    scanout_totals.transfer_stalls += stats.transfer_stalls;
     frame++;
   }
 
   esp_restart();
 }
+
+extern "C" void IRAM_ATTR app_main() {
+  SetupI2C();
+  SetupSPI();
+  if (!SetupCalibrationStore())
+    printf("NVS unavailable, calibrating the sensor on every boot\n");
+
+  auto* context = new RenderContext();
+  context->display = std::unique_ptr<Display>(new Display());
+  context->sensor_created = xTaskGetTickCount();
+  context->sensor_task = std::unique_ptr<SensorTask>(
+      new SensorTask(DistanceSensor::Create(), kSensorPeriodMs));
+  context->rainbow_fx = std::unique_ptr<RainbowFX>(new RainbowFX());
+  if (kBenchmarkAtStartup) {
+    auto& rainbow_fx = context->rainbow_fx;
+    auto& display = context->display;
+    // Commands, DC switches and FIFO writes of a full frame, with nothing to
+    // render.
+    printf("transport per frame: ");
+    Benchmark([&]() IRAM_ATTR {
+      display->Render([](uint32_t*, size_t) IRAM_ATTR {});
+    });
+    // A full frame of the scene, resolved and scanned out.
+    printf("full frame: ");
+    Benchmark([&]() IRAM_ATTR {
+      Render(*rainbow_fx, 1234);
+      rainbow_fx->BeginRender(true);
+      display->Render(rainbow_fx->scan_rects(), rainbow_fx->scan_rect_count(),
+                      [&](uint32_t* pixels, size_t count) IRAM_ATTR {
+                        rainbow_fx->Render(pixels, count);
+                      });
+    });
+  }
+  printf("heap free: %d\n", esp_get_free_heap_size());
+  constexpr size_t kAssetBytes = sizeof(kSpriteData) + sizeof(kSpriteSpanData) +
+                                 sizeof(kGlyphData) + sizeof(kGlyphSpanData);
+  printf("assets: %u bytes in flash, %u bytes of DRAM reclaimed\n",
+         kAssetBytes, kAssetBytes - AssetCache::kBytes);
+  esp_set_cpu_freq(ESP_CPU_FREQ_160M);
+
+  // The render task starts waiting for measurements right away, so it has
+  // to exist before the sensor task can notify it.
+  TaskHandle_t render_task;
+  if (xTaskCreate(RenderTask, "render", kRenderTaskStackDepth, context,
+                  kRenderTaskPriority, &render_task) != pdPASS ||
+      !context->sensor_task->Start(render_task, kSensorTaskPriority,
+                                   kSensorTaskStackDepth)) {
+    printf("Failed to create tasks, rebooting...\n");
+    esp_restart();
+  }
+  // The tasks own everything from here on.
+  vTaskDelete(nullptr);
+}
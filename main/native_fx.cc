@@ -0,0 +1,153 @@
+#include "native_fx.h"
+
+#include <esp_system.h>
+#include <string.h>
+
+#include "font.h"
+#include "sprites.h"
+#include "util.h"
+
+constexpr Display::Rect NativeFX::kScanRect;
+
+NativeFX::NativeFX() {
+  SetPalette(kPalette);
+  CommitPalette();
+}
+
+void IRAM_ATTR NativeFX::BeginRender() {
+  if (palette_changed_)
+    CommitPalette();
+  asset_cache_.NextFrame();
+  backbuffer_ptr_ = backbuffer_pixels_.data();
+}
+
+void IRAM_ATTR NativeFX::Clear() {
+  ClearWords(reinterpret_cast<uint32_t*>(backbuffer_pixels_.data()),
+             backbuffer_pixels_.size() / 4);
+}
+
+void IRAM_ATTR NativeFX::FadePalette(uint8_t amount, uint32_t target_rgb) {
+  uint32_t target = ExplodeRGB565(PackRGB565(target_rgb));
+  for (size_t i = 0; i < pending_palette_.size(); i++)
+    pending_palette_[i] = LerpExplodedRGB565(base_palette_[i], target, amount);
+  palette_changed_ = true;
+}
+
+void IRAM_ATTR NativeFX::SetPalette(const std::array<uint32_t, 16>& palette) {
+  base_palette_ = palette;
+  pending_palette_ = palette;
+  palette_changed_ = true;
+}
+
+void IRAM_ATTR NativeFX::CommitPalette() {
+  palette_changed_ = false;
+  for (size_t i = 0; i < colors_.size(); i++) {
+    uint32_t mix = (pending_palette_[i & 0x0f] + pending_palette_[i >> 4]) >> 1;
+    colors_[i] = __builtin_bswap16(UnexplodeRGB565(mix));
+    colors_332_[i] = UnexplodeRGB332(mix);
+  }
+}
+
+void IRAM_ATTR NativeFX::MeasureText(const char* text,
+                                     uint16_t& w,
+                                     uint16_t& h) {
+  w = 0;
+  h = 0;
+  while (*text) {
+    const auto& g = kGlyphs[*text - kFirstGlyph];
+    w += g.width;
+    h = std::max(h, static_cast<uint16_t>(g.height));
+    text++;
+  }
+}
+
+void IRAM_ATTR NativeFX::FillSpan(uint8_t* dest,
+                                  uint8_t start,
+                                  uint8_t length) {
+  dest += start;
+  if (!(length & kHalfCoverage)) {
+    memset(dest, 0xff, length);
+    return;
+  }
+  // Half the white of the text, half the first color underneath.
+  for (length &= ~kHalfCoverage; length; length--, dest++)
+    *dest = 0x0f | (*dest << 4);
+}
+
+void IRAM_ATTR NativeFX::DrawText(const char* text, int x, int y) {
+  // RainbowFX composites the glyphs at even columns, i.e., at whole display
+  // pixels, but any row.
+  int phase = y & 1;
+  uint8_t* row = &backbuffer_pixels_[(y - phase) / 2 * kWidth];
+  for (; *text >= kFirstGlyph && *text <= kLastGlyph; text++) {
+    const auto& g = kGlyphs[*text - kFirstGlyph];
+    const auto& native = kNativeGlyphs[*text - kFirstGlyph][phase];
+    // See encode_native_spans() in font2c.py for the format.
+    const uint8_t* spans = asset_cache_.Get(
+        &kNativeGlyphSpanData[native.span_offset / 4], native.span_size);
+    uint8_t* dest = row + x / 2;
+    for (int rows = (g.height + phase + 1) / 2; rows; rows--, dest += kWidth) {
+      for (uint8_t count = *spans++; count; count--, spans += 2)
+        FillSpan(dest, spans[0], spans[1]);
+    }
+    x += g.width;
+  }
+}
+
+void IRAM_ATTR NativeFX::DrawPrefilteredSprite(const Sprite& sprite,
+                                               int pos_x,
+                                               int pos_y) {
+  int phase = pos_y & 1;
+  int x = pos_x / 2;
+  int y = (pos_y - phase) / 2;
+  int stride = sprite.width / 2;
+  int width = stride;
+  int height = (sprite.height + phase + 1) / 2;
+  int skip_rows = 0;
+  if (y < 0) {
+    skip_rows = -y;
+    height -= skip_rows;
+    y = 0;
+  }
+  if (y + height > kHeight)
+    height = kHeight - y;
+  if (width > kWidth - x)
+    width = kWidth - x;
+  if (height <= 0 || width <= 0)
+    return;
+
+  const uint8_t* src =
+      asset_cache_.Get(&kNativeSpriteData[sprite.native_offset[phase] / 4],
+                       stride * (skip_rows + height)) +
+      skip_rows * stride;
+  uint8_t* dest = &backbuffer_pixels_[y * kWidth + x];
+  for (; height; height--, src += stride, dest += kWidth)
+    DrawPrefilteredRow(dest, src, width);
+}
+
+__attribute__((always_inline)) static inline void DrawPrefilteredWord(
+    uint8_t* dest,
+    uint32_t pixels,
+    size_t bytes) {
+  // See native_pixel() in sprites2c.py. Bytes with a zero high nibble are
+  // mixed with the first color underneath, and zero bytes are transparent.
+  uint32_t non_zero = NonZeroNibbles(pixels);
+  uint32_t high = (non_zero >> 4) & 0x01010101;
+  uint32_t low = non_zero & ~high & 0x01010101;
+  if (!(high | low))
+    return;
+  uint32_t word = LoadNibbles(dest, bytes);
+  uint32_t mixed = (pixels & 0x0f0f0f0f) | ((word & 0x0f0f0f0f) << 4);
+  word = BlendNibbles(word, pixels, high * 0xff);
+  word = BlendNibbles(word, mixed, low * 0xff);
+  StoreNibbles(dest, word, bytes);
+}
+
+void IRAM_ATTR NativeFX::DrawPrefilteredRow(uint8_t* dest,
+                                            const uint8_t* src,
+                                            int count) {
+  for (; count >= 4; count -= 4, src += 4, dest += 4)
+    DrawPrefilteredWord(dest, LoadNibbles(src), 4);
+  for (; count > 0; count--, src++, dest++)
+    DrawPrefilteredWord(dest, *src, 1);
+}
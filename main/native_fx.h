@@ -0,0 +1,208 @@
+#pragma once
+
+#include <array>
+
+#include "asset_cache.h"
+#include "display.h"
+#include "nibble.h"
+#include "rainbow_fx.h"
+#include "sprites.h"
+
+// A display resolution alternative to RainbowFX's supersampled backbuffer.
+// Instead of resolving 2x2 blocks at scan-out, the edges are anti-aliased
+// offline: the asset generators pre-filter the glyphs and the sprites drawn
+// at backbuffer resolution to half size, with partially covered pixels.
+//
+// Each backbuffer byte is one display pixel, an even mix of two palette
+// colors (low and high nibble), so a covered edge blends with whatever is
+// underneath. That is half the memory of RainbowFX and one table lookup per
+// pixel to resolve, at the cost of coarser coverage levels.
+//
+// The drawing calls take the same arguments as RainbowFX's, in its backbuffer
+// coordinates, so scenes can draw to either. There is no damage tracking or
+// palette animation; every scan-out covers the whole screen.
+class NativeFX {
+ public:
+  static constexpr auto kWidth = Display::kWidth;
+  static constexpr auto kHeight = Display::kHeight;
+
+  using DefaultDrawTraits = RainbowFX::DefaultDrawTraits;
+  using BlendDrawTraits = RainbowFX::BlendDrawTraits;
+  using BlendDrawTraits1X = RainbowFX::BlendDrawTraits1X;
+  using SpanDrawTraits = RainbowFX::SpanDrawTraits;
+  using SpanDrawTraits1X = RainbowFX::SpanDrawTraits1X;
+
+  NativeFX();
+
+  // Prepares the scan-out of the whole screen.
+  void BeginRender();
+  // Resolves the next |count| pixels of the scan-out into |pixels|, in the
+  // format of |kColorMode|.
+  template <Display::ColorMode kColorMode = Display::kColorMode>
+  void Render(uint32_t* pixels, size_t count);
+
+  const Display::Rect* scan_rects() const { return &kScanRect; }
+  size_t scan_rect_count() const { return 1; }
+
+  void Clear();
+
+  // Like RainbowFX, these take effect at the next BeginRender().
+  void FadePalette(uint8_t amount, uint32_t target_rgb = 0);
+  void SetPalette(const std::array<uint32_t, 16>& palette);
+
+  void MeasureText(const char* text, uint16_t& w, uint16_t& h);
+  void DrawText(const char* text, int x, int y);
+
+  // Sprites drawn with |kScale2x| are already at display resolution. The
+  // others use the pre-filtered copy in kNativeSpriteData, which always
+  // blends.
+  template <typename DrawTraits = DefaultDrawTraits>
+  void DrawSprite(const Sprite& sprite, int x, int y);
+
+  const AssetCache::Stats& asset_cache_stats() const {
+    return asset_cache_.stats();
+  }
+
+ private:
+  static constexpr Display::Rect kScanRect = {0, 0, Display::kWidth,
+                                              Display::kHeight};
+  // Set on the length of half covered glyph spans.
+  static constexpr uint8_t kHalfCoverage = 0x80;
+
+  void CommitPalette();
+  void DrawPrefilteredSprite(const Sprite& sprite, int pos_x, int pos_y);
+  // Draws |count| pre-filtered pixels from |src| to |dest|.
+  static void DrawPrefilteredRow(uint8_t* dest, const uint8_t* src, int count);
+  // Draws |count| bytes of 4bpp sprite pixels to |dest|, each pixel as one
+  // byte, skipping transparent pixels if |kBlend| is set.
+  template <bool kBlend>
+  static void DrawSpriteRow(uint8_t* dest, const uint8_t* src, int count);
+  template <bool kBlend>
+  static void DrawSpriteWord(uint8_t* dest, uint32_t pixels, size_t bytes);
+  static void FillSpan(uint8_t* dest, uint8_t start, uint8_t length);
+
+  std::array<uint8_t, kWidth * kHeight> backbuffer_pixels_
+      __attribute__((aligned)) = {};
+
+  // The color of every possible backbuffer byte, as byte swapped RGB565 and
+  // as RGB332.
+  std::array<uint16_t, 256> colors_;
+  std::array<uint8_t, 256> colors_332_;
+
+  std::array<uint32_t, 16> pending_palette_;
+  bool palette_changed_ = false;
+  // The palette set by SetPalette(), which FadePalette() fades from.
+  std::array<uint32_t, 16> base_palette_;
+
+  AssetCache asset_cache_;
+  const uint8_t* backbuffer_ptr_ = nullptr;
+};
+
+template <typename DrawTraits>
+void IRAM_ATTR NativeFX::DrawSprite(const Sprite& sprite,
+                                    int pos_x,
+                                    int pos_y) {
+  if (!DrawTraits::kScale2x) {
+    DrawPrefilteredSprite(sprite, pos_x, pos_y);
+    return;
+  }
+  // Every sprite pixel is a display pixel, and |pos_y| is already in display
+  // rows. Clipped like RainbowFX::DrawSprite().
+  int x = pos_x / 2;
+  int width = sprite.width;
+  int height = sprite.height;
+  int skip_rows = 0;
+  if (pos_y < 0) {
+    skip_rows = -pos_y;
+    height -= skip_rows;
+    pos_y = 0;
+  }
+  if (pos_y + height > kHeight)
+    height = kHeight - pos_y;
+  if (width > ((kWidth - x) & ~1))
+    width = (kWidth - x) & ~1;
+  if (height <= 0 || width <= 0)
+    return;
+
+  uint8_t* dest = &backbuffer_pixels_[pos_y * kWidth + x];
+  if (!DrawTraits::kSpans) {
+    const uint8_t* sprite_bits =
+        asset_cache_.Get(&kSpriteData[sprite.offset / 4],
+                         sprite.width / 2 * sprite.height) +
+        skip_rows * (sprite.width / 2);
+    for (int y = 0; y < height; y++, dest += kWidth) {
+      DrawSpriteRow<DrawTraits::kBlend>(dest, sprite_bits, width / 2);
+      sprite_bits += sprite.width / 2;
+    }
+    return;
+  }
+
+  // See encode_spans() in sprites2c.py for the format.
+  const uint8_t* spans = asset_cache_.Get(
+      &kSpriteSpanData[sprite.span_offset / 4], sprite.span_size);
+  while (skip_rows--) {
+    while (spans[1])
+      spans += 2 + (spans[1] & 0x7f);
+    spans += 2;
+  }
+  int width_bytes = width / 2;
+  for (int y = 0; y < height; y++, dest += kWidth) {
+    int sx = 0;
+    while (uint8_t count = spans[1]) {
+      sx += spans[0];
+      spans += 2;
+      bool masked = count & 0x80;
+      count &= 0x7f;
+      int visible = std::min<int>(count, width_bytes - sx);
+      if (masked) {
+        DrawSpriteRow<true>(dest + 2 * sx, spans, visible);
+      } else {
+        DrawSpriteRow<false>(dest + 2 * sx, spans, visible);
+      }
+      spans += count;
+      sx += count;
+    }
+    spans += 2;
+  }
+}
+
+template <bool kBlend>
+__attribute__((always_inline)) inline void NativeFX::DrawSpriteWord(
+    uint8_t* dest,
+    uint32_t pixels,
+    size_t bytes) {
+  // The four pixels in the low half of |pixels| become a word of solid
+  // colors, of which the first |bytes| bytes are drawn.
+  uint32_t mask = kBlend ? DoubleNibbles(OpaqueMask(pixels))
+                         : ~0u >> (32 - 8 * bytes);
+  if (kBlend && !mask)
+    return;
+  uint32_t word = LoadNibbles(dest, bytes);
+  StoreNibbles(dest, BlendNibbles(word, DoubleNibbles(pixels), mask), bytes);
+}
+
+template <bool kBlend>
+void IRAM_ATTR NativeFX::DrawSpriteRow(uint8_t* dest,
+                                       const uint8_t* src,
+                                       int count) {
+  for (; count >= 2; count -= 2, src += 2, dest += 4)
+    DrawSpriteWord<kBlend>(dest, LoadNibbles(src, 2), 4);
+  if (count > 0)
+    DrawSpriteWord<kBlend>(dest, *src, 2);
+}
+
+template <Display::ColorMode kColorMode>
+__attribute__((always_inline)) inline void NativeFX::Render(uint32_t* pixels,
+                                                            size_t count) {
+  // One lookup per pixel, two pixels at a time.
+  const uint8_t* src = backbuffer_ptr_;
+  if (kColorMode == Display::COLOR_MODE_256) {
+    auto* pairs = reinterpret_cast<uint16_t*>(pixels);
+    for (size_t i = 0; i < count / 2; i++, src += 2)
+      *pairs++ = colors_332_[src[0]] | (colors_332_[src[1]] << 8);
+  } else {
+    for (size_t i = 0; i < count / 2; i++, src += 2)
+      *pixels++ = colors_[src[0]] | (colors_[src[1]] << 16);
+  }
+  backbuffer_ptr_ = src;
+}
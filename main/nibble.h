@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// SWAR kernels for packed 4 bits per pixel data, eight pixels per 32-bit
+// word. Words are little-endian, so the first pixel of a word is its lowest
+// nibble, like the first pixel of a byte.
+
+// Loads or stores the first |count| (1-4) bytes of a word, from or to memory
+// of any alignment.
+inline uint32_t LoadNibbles(const uint8_t* bytes, size_t count = 4) {
+  uint32_t word = 0;
+  memcpy(&word, bytes, count);
+  return word;
+}
+
+inline void StoreNibbles(uint8_t* bytes, uint32_t word, size_t count = 4) {
+  memcpy(bytes, &word, count);
+}
+
+inline void ClearWords(uint32_t* words, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    words[i] = 0;
+}
+
+// Like memmove(), for overlapping rows of the same buffer.
+inline void MoveWords(uint32_t* dest, const uint32_t* src, size_t count) {
+  if (dest < src) {
+    for (size_t i = 0; i < count; i++)
+      dest[i] = src[i];
+  } else {
+    for (size_t i = count; i > 0; i--)
+      dest[i - 1] = src[i - 1];
+  }
+}
+
+// The lowest bit of every non-zero nibble.
+inline uint32_t NonZeroNibbles(uint32_t word) {
+  return (word | (word >> 1) | (word >> 2) | (word >> 3)) & 0x11111111;
+}
+
+// Subtracts one from every non-zero nibble.
+inline uint32_t DecrementNibbles(uint32_t word) {
+  return word - NonZeroNibbles(word);
+}
+
+// 0xf for every non-zero (i.e., opaque) pixel.
+inline uint32_t OpaqueMask(uint32_t word) {
+  return NonZeroNibbles(word) * 0xf;
+}
+
+// Replaces the pixels of |dest| with those of |src| where |mask| is set.
+inline uint32_t BlendNibbles(uint32_t dest, uint32_t src, uint32_t mask) {
+  return dest ^ ((dest ^ src) & mask);
+}
+
+// Doubles the four pixels in the low half of |word| horizontally, i.e., every
+// pixel becomes a byte.
+inline uint32_t DoubleNibbles(uint32_t word) {
+  word &= 0xffff;
+  word = (word | (word << 8)) & 0x00ff00ff;
+  word = (word | (word << 4)) & 0x0f0f0f0f;
+  return word | (word << 4);
+}
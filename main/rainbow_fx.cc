@@ -1,20 +1,32 @@
 #include "rainbow_fx.h"
 
 #include <esp_system.h>
+#include <string.h>
 
 #include "font.h"
 #include "sprites.h"
 #include "util.h"
 
 RainbowFX::RainbowFX() {
+  SetPalette(kPalette);
+  CommitPalette();
   Clear();
 }
 
 RainbowFX::~RainbowFX() = default;
 
+void IRAM_ATTR RainbowFX::Invalidate() {
+  damage_.Clear();
+  damage_.Add(Display::Rect{0, 0, Display::kWidth, Display::kHeight});
+  valid_row_signatures_ = 0;
+}
+
 void IRAM_ATTR RainbowFX::Clear() {
-  for (auto& pixel : backbuffer_pixels_)
-    pixel = 0;
+  // Everything drawn since the last clear is about to be erased.
+  damage_.Add(drawn_);
+  drawn_.Clear();
+  ClearWords(reinterpret_cast<uint32_t*>(backbuffer_pixels_.data()),
+             backbuffer_pixels_.size() / 4);
   // Test pattern:
   //
   // int index = 0;
@@ -25,40 +37,223 @@ void IRAM_ATTR RainbowFX::Clear() {
   //}
 }
 
-void IRAM_ATTR RainbowFX::Fade() {
-  for (uint8_t& pair : backbuffer_pixels_) {
-    uint8_t p0 = pair & 0b00001111;
-    uint8_t p1 = pair & 0b11110000;
-    p0 = p0 ? p0 - 0b00000001 : p0;
-    p1 = p1 ? p1 - 0b00010000 : p1;
-    pair = p0 | p1;
+void IRAM_ATTR RainbowFX::set_background_layer(bool enabled) {
+  background_layer_ = enabled;
+  // Drawn again from scratch by the next ScrollBackground().
+  background_valid_ = false;
+  background_first_ = background_last_;
+  Invalidate();
+}
+
+void IRAM_ATTR RainbowFX::ScrollBackground(int top) {
+  int first = top;
+  int last = top + Display::kHeight;
+  if (background_valid_) {
+    if (top == background_top_)
+      return;
+    // Rows still in view keep their place in the ring, as do those that came
+    // into view earlier in the frame.
+    if (top > background_top_) {
+      first = std::max(first, background_top_ + Display::kHeight);
+    } else {
+      last = std::min(last, background_top_);
+    }
+    if (background_first_ < background_last_) {
+      first = std::max(std::min(first, background_first_), top);
+      last = std::min(std::max(last, background_last_),
+                      top + static_cast<int>(Display::kHeight));
+    }
+  }
+  for (int row = first; row < last; row++) {
+    ClearWords(reinterpret_cast<uint32_t*>(BackgroundLine(row)),
+               kBackgroundLineBytes / 4);
+    stale_background_signatures_ |= 1ull << (row & (Display::kHeight - 1));
+  }
+  background_top_ = top;
+  background_first_ = first;
+  background_last_ = last;
+  background_valid_ = true;
+  background_moved_ = true;
+}
+
+void IRAM_ATTR RainbowFX::DrawBackgroundPixels(uint8_t* line,
+                                               int column,
+                                               const uint8_t* src,
+                                               int count) {
+  // Only rows that came into view are drawn, so this is rare enough to go a
+  // pixel at a time, at any column.
+  for (int i = 0; i < count; i++, column++) {
+    uint8_t pixel = (src[i / 2] >> (4 * (i & 1))) & 0x0f;
+    if (!pixel || column < 0 || column >= Display::kWidth)
+      continue;
+    uint8_t& pair = line[column / 2];
+    int shift = 4 * (column & 1);
+    pair = (pair & ~(0x0f << shift)) | (pixel << shift);
+  }
+}
+
+void IRAM_ATTR RainbowFX::DrawBackgroundSprite(const Sprite& sprite,
+                                               int x,
+                                               int y) {
+  int first = std::max(background_first_ - y, 0);
+  int last = std::min(background_last_ - y, static_cast<int>(sprite.height));
+  if (first >= last)
+    return;
+  // See encode_spans() in sprites2c.py for the format.
+  const uint8_t* spans = asset_cache_.Get(
+      &kSpriteSpanData[sprite.span_offset / 4], sprite.span_size);
+  for (int row = 0; row < first; row++)
+    spans = SkipSpanRow(spans);
+  for (int row = first; row < last; row++) {
+    uint8_t* line = BackgroundLine(y + row);
+    int column = x / 2;
+    while (uint8_t count = spans[1]) {
+      column += 2 * spans[0];
+      spans += 2;
+      count &= 0x7f;
+      DrawBackgroundPixels(line, column, spans, 2 * count);
+      spans += count;
+      column += 2 * count;
+    }
+    spans += 2;
+  }
+}
+
+void IRAM_ATTR RainbowFX::FadePalette(uint8_t amount, uint32_t target_rgb) {
+  fade_amount_ = amount;
+  fade_target_ = ExplodeRGB565(PackRGB565(target_rgb));
+  ApplyFade();
+}
+
+void IRAM_ATTR RainbowFX::SetPalette(const std::array<uint32_t, 16>& palette) {
+  base_palette_ = palette;
+  fade_amount_ = 0;
+  ApplyFade();
+}
+
+void IRAM_ATTR RainbowFX::CyclePalette(uint8_t first, uint8_t last) {
+  if (first >= last || last >= base_palette_.size())
+    return;
+  uint32_t color = base_palette_[last];
+  for (size_t i = last; i > first; i--)
+    base_palette_[i] = base_palette_[i - 1];
+  base_palette_[first] = color;
+  ApplyFade();
+}
+
+void IRAM_ATTR RainbowFX::GradientPalette(uint8_t first,
+                                          uint8_t last,
+                                          uint32_t first_rgb,
+                                          uint32_t last_rgb) {
+  if (first > last || last >= base_palette_.size())
+    return;
+  uint32_t from = ExplodeRGB565(PackRGB565(first_rgb));
+  uint32_t to = ExplodeRGB565(PackRGB565(last_rgb));
+  for (size_t i = first; i <= last; i++) {
+    uint8_t amount = first == last ? 0 : (i - first) * 255 / (last - first);
+    base_palette_[i] = LerpExplodedRGB565(from, to, amount);
+  }
+  ApplyFade();
+}
+
+void IRAM_ATTR RainbowFX::ApplyFade() {
+  for (size_t i = 0; i < pending_palette_.size(); i++) {
+    pending_palette_[i] =
+        LerpExplodedRGB565(base_palette_[i], fade_target_, fade_amount_);
+  }
+  palette_changed_ = true;
+}
+
+void IRAM_ATTR RainbowFX::CommitPalette() {
+  palette_changed_ = false;
+  palette_ = pending_palette_;
+  for (size_t i = 0; i < pair_sums_.size(); i++)
+    pair_sums_[i] = palette_[i & 0b00001111] + palette_[(i & 0b11110000) >> 4];
+  // Every pixel may have changed color.
+  Invalidate();
+}
+
+void IRAM_ATTR RainbowFX::SetRasterColors(
+    uint8_t index,
+    const std::array<uint32_t, Display::kHeight>& colors) {
+  pending_raster_index_ = index & 0x0f;
+  pending_raster_colors_ = colors;
+  raster_changed_ = true;
+}
+
+void IRAM_ATTR RainbowFX::ClearRasterColors() {
+  pending_raster_index_ = kNoRaster;
+  raster_changed_ = true;
+}
+
+void IRAM_ATTR RainbowFX::CommitRasterColors() {
+  raster_changed_ = false;
+  if (pending_raster_index_ != raster_index_) {
+    // The overridden entry needs to be restored from the palette.
+    palette_changed_ = true;
+  } else if (raster_index_ != kNoRaster) {
+    for (size_t row = 0; row < Display::kHeight; row++) {
+      if (pending_raster_colors_[row] == raster_colors_[row])
+        continue;
+      damage_.Add(Display::Rect{0, static_cast<uint8_t>(row), Display::kWidth,
+                                static_cast<uint8_t>(row + 1)});
+      // The contents are the same, but the row has to be sent again.
+      valid_row_signatures_ &= ~(1ull << row);
+    }
+  }
+  raster_index_ = pending_raster_index_;
+  raster_colors_ = pending_raster_colors_;
+}
+
+void IRAM_ATTR RainbowFX::ApplyRasterColor(size_t row) {
+  uint32_t color = raster_colors_[row];
+  if (palette_[raster_index_] == color)
+    return;
+  // Update the palette entry and every pair sum that includes it.
+  palette_[raster_index_] = color;
+  for (size_t i = 0; i < 16; i++) {
+    pair_sums_[(raster_index_ << 4) | i] = color + palette_[i];
+    pair_sums_[(i << 4) | raster_index_] = palette_[i] + color;
   }
 }
 
 void IRAM_ATTR RainbowFX::Move(int16_t delta) {
+  Damage(0, 0, kWidth, kHeight);
+  constexpr size_t kLineWords = kWidth * kBackbufferBitsPerPixel / 32;
+  uint32_t* rows = reinterpret_cast<uint32_t*>(backbuffer_pixels_.data());
   if (delta > 0) {
     if (delta >= kHeight)
       delta = kHeight - 1;
-    const uint8_t* src = &backbuffer_pixels_[delta * kWidth / 2];
-    uint8_t* dst = &backbuffer_pixels_[0];
-    std::copy(src, src + kWidth * (kHeight - delta) / 2, dst);
+    MoveWords(rows, rows + delta * kLineWords, (kHeight - delta) * kLineWords);
   } else {
     delta = -delta;
     if (delta >= kHeight)
       delta = kHeight - 1;
-    const uint8_t* src = &backbuffer_pixels_[0];
-    uint8_t* dst = &backbuffer_pixels_[delta * kWidth / 2];
-    std::copy(src, src + kWidth * (kHeight - delta) / 2, dst);
+    MoveWords(rows + delta * kLineWords, rows, (kHeight - delta) * kLineWords);
   }
 }
 
+template <RainbowFX::GlyphKernel kKernel>
 const Glyph* IRAM_ATTR RainbowFX::DrawGlyph(uint8_t glyph,
                                             int pos_x,
                                             int pos_y) {
   if (glyph < kFirstGlyph || glyph > kLastGlyph)
     return nullptr;
   const auto& g = kGlyphs[glyph - kFirstGlyph];
-  const uint32_t* glyph_bits = &kGlyphData[g.offset];
+  Damage(pos_x, pos_y, pos_x + g.width, pos_y + g.height);
+  if (kKernel == GlyphKernel::kSpans) {
+    const uint8_t* spans =
+        asset_cache_.Get(&kGlyphSpanData[g.span_offset / 4], g.span_size);
+    for (size_t y = 0; y < g.height; y++) {
+      uint8_t* dest = &backbuffer_pixels_[((pos_y + y) * kWidth + pos_x) / 2];
+      for (uint8_t count = *spans++; count; count--, spans += 2)
+        FillSpan(dest, spans[0], spans[0] + spans[1]);
+    }
+    return &g;
+  }
+  size_t row_words = (g.width + 31) / 32;
+  const uint32_t* glyph_bits = reinterpret_cast<const uint32_t*>(
+      asset_cache_.Get(&kGlyphData[g.offset], g.height * row_words * 4));
   for (size_t y = 0; y < g.height; y++) {
     uint8_t* dest = &backbuffer_pixels_[((pos_y + y) * kWidth + pos_x) / 2];
     for (size_t x = 0; x < g.width; x += 32) {
@@ -75,6 +270,15 @@ const Glyph* IRAM_ATTR RainbowFX::DrawGlyph(uint8_t glyph,
   return &g;
 }
 
+template const Glyph* RainbowFX::DrawGlyph<RainbowFX::GlyphKernel::kBits>(
+    uint8_t glyph,
+    int pos_x,
+    int pos_y);
+template const Glyph* RainbowFX::DrawGlyph<RainbowFX::GlyphKernel::kSpans>(
+    uint8_t glyph,
+    int pos_x,
+    int pos_y);
+
 void IRAM_ATTR RainbowFX::MeasureText(const char* text,
                                       uint16_t& w,
                                       uint16_t& h) {
@@ -88,7 +292,435 @@ void IRAM_ATTR RainbowFX::MeasureText(const char* text,
   }
 }
 
-void IRAM_ATTR RainbowFX::BeginRender() {
-  backbuffer_ptr_ = &backbuffer_pixels_[0];
-  render_column_ = 0;
+void IRAM_ATTR RainbowFX::FillSpan(uint8_t* dest, size_t start, size_t end) {
+  // Fill the odd pixels at either end and the whole bytes in between.
+  if (start & 1)
+    dest[start++ / 2] |= 0xf0;
+  if (end & 1)
+    dest[--end / 2] |= 0x0f;
+  if (start < end)
+    memset(&dest[start / 2], 0xff, (end - start) / 2);
+}
+
+void IRAM_ATTR RainbowFX::DrawText(const char* text, int x, int y) {
+  for (; *text; text++) {
+    auto glyph = DrawGlyph(*text, x, y);
+    if (!glyph)
+      break;
+    x += glyph->width;
+  }
+}
+
+void IRAM_ATTR RainbowFX::DamageList::Add(const Display::Rect& rect) {
+  auto merge = [](const Display::Rect& a, const Display::Rect& b) {
+    return Display::Rect{std::min(a.x0, b.x0), std::min(a.y0, b.y0),
+                         std::max(a.x1, b.x1), std::max(a.y1, b.y1)};
+  };
+  // Merge into an existing rectangle if that doesn't scan out any extra
+  // pixels, or into the one that grows the least if the list is full.
+  size_t best = 0;
+  int best_growth = INT32_MAX;
+  for (size_t i = 0; i < count; i++) {
+    int growth = merge(rects[i], rect).area() - rects[i].area() - rect.area();
+    if (growth < best_growth) {
+      best = i;
+      best_growth = growth;
+    }
+  }
+  if (best_growth <= 0 || count == rects.size()) {
+    rects[best] = merge(rects[best], rect);
+    return;
+  }
+  rects[count++] = rect;
+}
+
+void IRAM_ATTR RainbowFX::DamageList::Add(const DamageList& other) {
+  for (size_t i = 0; i < other.count; i++)
+    Add(other.rects[i]);
+}
+
+uint32_t IRAM_ATTR RainbowFX::DamageList::area() const {
+  uint32_t pixels = 0;
+  for (size_t i = 0; i < count; i++)
+    pixels += rects[i].area();
+  return pixels;
+}
+
+void IRAM_ATTR RainbowFX::Damage(int x0, int y0, int x1, int y1) {
+  x0 = std::max(x0, 0);
+  y0 = std::max(y0, 0);
+  x1 = std::min(x1, static_cast<int>(kWidth));
+  y1 = std::min(y1, static_cast<int>(kHeight));
+  if (x0 >= x1 || y0 >= y1)
+    return;
+
+  // Convert to display pixels, rounding outwards to whole pixel pairs.
+  Display::Rect rect;
+  rect.x0 = (x0 / kSuperSampling) & ~1;
+  rect.x1 = ((x1 + kSuperSampling - 1) / kSuperSampling + 1) & ~1;
+  rect.y0 = y0 / kSuperSampling;
+  rect.y1 = (y1 + kSuperSampling - 1) / kSuperSampling;
+  damage_.Add(rect);
+  drawn_.Add(rect);
+}
+
+const uint32_t* RainbowFX::RowWords(size_t row) const {
+  return reinterpret_cast<const uint32_t*>(
+      &backbuffer_pixels_[row * kSuperSampling * kWidth *
+                          kBackbufferBitsPerPixel / 8]);
+}
+
+static constexpr size_t kRowWords =
+    RainbowFX::kSuperSampling * RainbowFX::kWidth *
+    RainbowFX::kBackbufferBitsPerPixel / 32;
+
+static constexpr size_t kBackgroundRowWords = Display::kWidth / 8;
+
+static uint32_t IRAM_ATTR MixSignature(uint32_t signature,
+                                       const uint32_t* words,
+                                       size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    signature = (signature ^ words[i]) * 0x9e3779b1;
+    signature ^= signature >> 15;
+  }
+  return signature;
+}
+
+uint32_t IRAM_ATTR RainbowFX::RowSignature(size_t row) const {
+  uint32_t signature = backbuffer_signatures_[row];
+  if (background_layer_) {
+    signature = MixSignature(
+        signature, &background_signatures_[BackgroundRowIndex(row)], 1);
+  }
+  return signature;
+}
+
+static bool IRAM_ATTR UniformWords(const uint32_t* words,
+                                   size_t count,
+                                   uint8_t& color) {
+  uint32_t first = words[0];
+  if (first != (first & 0x0f) * 0x11111111)
+    return false;
+  for (size_t i = 1; i < count; i++) {
+    if (words[i] != first)
+      return false;
+  }
+  color = first & 0x0f;
+  return true;
+}
+
+bool IRAM_ATTR RainbowFX::UniformRow(size_t row, uint8_t& color) const {
+  if (!UniformWords(RowWords(row), kRowWords, color))
+    return false;
+  if (color || !background_layer_)
+    return true;
+  // All transparent, so it is up to the background.
+  return UniformWords(reinterpret_cast<const uint32_t*>(BackgroundRow(row)),
+                      kBackgroundRowWords, color);
+}
+
+int IRAM_ATTR RainbowFX::FindScroll(
+    const std::array<uint32_t, Display::kHeight>& signatures,
+    uint64_t changed_rows) const {
+  // Pixel data that would have to be sent without scrolling.
+  DamageList scan_rects;
+  AddScanRects(damage_, changed_rows, scan_rects);
+  int unscrolled = PixelBytes(scan_rects.area());
+  int best_scroll = 0;
+  int best_saving = 0;
+  for (int scroll = -kMaxScrollRows; scroll <= kMaxScrollRows; scroll++) {
+    if (!scroll)
+      continue;
+    size_t copies = ScrollCopies(scroll);
+    if (copies > kMaxCommands)
+      continue;
+    // Rows that don't match their new source are sent in full.
+    int matches = 0;
+    for (int row = std::max(scroll, 0);
+         row < Display::kHeight + std::min(scroll, 0); row++) {
+      matches += signatures[row] == row_signatures_[row - scroll];
+    }
+    int saving = unscrolled -
+                 PixelBytes((Display::kHeight - matches) * Display::kWidth) -
+                 copies * Display::kCommandCostBytes;
+    if (saving > best_saving) {
+      best_scroll = scroll;
+      best_saving = saving;
+    }
+  }
+  if (!best_scroll)
+    return 0;
+
+  // The scan-out merges the rows into a few rectangles, which may cover rows
+  // in between, so check against the rectangles it would actually send.
+  DamageList damage;
+  uint64_t rows;
+  ScrollDamage(best_scroll, signatures, damage, rows);
+  scan_rects.Clear();
+  AddScanRects(damage, rows, scan_rects);
+  int scrolled = PixelBytes(scan_rects.area()) +
+                 ScrollCopies(best_scroll) * Display::kCommandCostBytes;
+  return scrolled < unscrolled ? best_scroll : 0;
+}
+
+void IRAM_ATTR RainbowFX::ScrollDamage(
+    int scroll,
+    const std::array<uint32_t, Display::kHeight>& signatures,
+    DamageList& damage,
+    uint64_t& rows) const {
+  damage.Clear();
+  rows = 0;
+  for (int row = 0; row < Display::kHeight; row++) {
+    int src = row - scroll;
+    if (src >= 0 && src < Display::kHeight &&
+        signatures[row] == row_signatures_[src]) {
+      continue;
+    }
+    damage.Add(Display::Rect{0, static_cast<uint8_t>(row), Display::kWidth,
+                             static_cast<uint8_t>(row + 1)});
+    rows |= 1ull << row;
+  }
+}
+
+size_t IRAM_ATTR RainbowFX::ScrollCopies(int scroll) {
+  // See AddScrollCommands().
+  return scroll < 0 ? 1 : (Display::kHeight + scroll - 1) / scroll - 1;
+}
+
+void IRAM_ATTR RainbowFX::AddScrollCommands(int scroll) {
+  if (scroll < 0) {
+    // Copying upwards in row order reads every row before overwriting it.
+    commands_[command_count_++] = {
+        Display::DrawCommand::kCopy,
+        {0, static_cast<uint8_t>(-scroll), Display::kWidth, Display::kHeight},
+        0,
+        0,
+        0};
+    return;
+  }
+  // Copy downwards in blocks no taller than the scroll distance, starting at
+  // the bottom, so that no block overlaps its destination.
+  for (int y1 = Display::kHeight - scroll; y1 > 0; y1 -= scroll) {
+    int y0 = std::max(y1 - scroll, 0);
+    commands_[command_count_++] = {
+        Display::DrawCommand::kCopy,
+        {0, static_cast<uint8_t>(y0), Display::kWidth, static_cast<uint8_t>(y1)},
+        0,
+        static_cast<uint8_t>(y0 + scroll),
+        0};
+  }
+}
+
+uint64_t IRAM_ATTR RainbowFX::AddFillCommands(uint64_t changed_rows) {
+  // Replace runs of changed rows of one solid color with a fill, if that is
+  // cheaper than sending their damaged pixels.
+  std::array<uint8_t, Display::kHeight> row_pixels = {};
+  for (size_t i = 0; i < damage_.count; i++) {
+    const auto& rect = damage_.rects[i];
+    for (size_t row = rect.y0; row < rect.y1; row++) {
+      row_pixels[row] =
+          std::min<int>(row_pixels[row] + rect.width(), Display::kWidth);
+    }
+  }
+  uint8_t color = 0;
+  size_t run_start = 0;
+  size_t run_rows = 0;
+  int run_bytes = 0;
+  for (size_t row = 0; row <= Display::kHeight; row++) {
+    uint8_t row_color = 0;
+    bool uniform = row < Display::kHeight && (changed_rows & (1ull << row)) &&
+                   UniformRow(row, row_color) && row_color != raster_index_;
+    if (uniform && run_rows && row_color == color) {
+      run_rows++;
+      run_bytes += PixelBytes(row_pixels[row]);
+      continue;
+    }
+    if (run_bytes > static_cast<int>(Display::kCommandCostBytes) &&
+        command_count_ < kMaxCommands) {
+      commands_[command_count_++] = {
+          Display::DrawCommand::kFill,
+          {0, static_cast<uint8_t>(run_start), Display::kWidth,
+           static_cast<uint8_t>(row)},
+          0,
+          0,
+          UnexplodeRGB565(palette_[color])};
+      changed_rows &= ~(((1ull << run_rows) - 1) << run_start);
+    }
+    color = row_color;
+    run_start = row;
+    run_rows = uniform ? 1 : 0;
+    run_bytes = uniform ? PixelBytes(row_pixels[row]) : 0;
+  }
+  return changed_rows;
+}
+
+void IRAM_ATTR RainbowFX::UpdateSignatures() {
+  for (size_t i = 0; stale_background_signatures_; i++) {
+    if (!(stale_background_signatures_ & (1ull << i)))
+      continue;
+    background_signatures_[i] = MixSignature(
+        0,
+        reinterpret_cast<const uint32_t*>(
+            &background_pixels_[i * kBackgroundLineBytes]),
+        kBackgroundRowWords);
+    stale_background_signatures_ &= ~(1ull << i);
+  }
+  // Only the damaged rows of the backbuffer may have changed.
+  uint64_t hashed_rows = 0;
+  for (size_t i = 0; i < damage_.count; i++) {
+    const auto& rect = damage_.rects[i];
+    for (size_t row = rect.y0; row < rect.y1; row++) {
+      if (hashed_rows & (1ull << row))
+        continue;
+      hashed_rows |= 1ull << row;
+      backbuffer_signatures_[row] = MixSignature(0, RowWords(row), kRowWords);
+    }
+  }
+  if (background_moved_) {
+    // Every display row shows another background row. The row signatures
+    // find the ones that are the same, and the panel copy the ones that
+    // moved.
+    background_moved_ = false;
+    damage_.Add(Display::Rect{0, 0, Display::kWidth, Display::kHeight});
+  }
+}
+
+void IRAM_ATTR RainbowFX::BeginRender(bool full_frame) {
+  asset_cache_.NextFrame();
+  // The background rows that came into view have been drawn.
+  background_first_ = background_last_;
+  UpdateSignatures();
+  if (raster_changed_)
+    CommitRasterColors();
+  if (palette_changed_)
+    CommitPalette();
+  if (full_frame)
+    Invalidate();
+
+  // Find the damaged rows whose contents actually changed since the last
+  // scan-out. Redrawing identical contents is common since every frame starts
+  // with a Clear().
+  std::array<uint32_t, Display::kHeight> signatures;
+  uint64_t checked_rows = 0;
+  uint64_t changed_rows = 0;
+  for (size_t i = 0; i < damage_.count; i++) {
+    const auto& rect = damage_.rects[i];
+    for (size_t row = rect.y0; row < rect.y1; row++) {
+      uint64_t bit = 1ull << row;
+      if (checked_rows & bit)
+        continue;
+      checked_rows |= bit;
+      signatures[row] = RowSignature(row);
+      if (!(valid_row_signatures_ & bit) ||
+          signatures[row] != row_signatures_[row]) {
+        changed_rows |= bit;
+      }
+    }
+  }
+
+  command_count_ = 0;
+  if (hardware_acceleration_ && !full_frame) {
+    // If the contents moved, the previous scan-out may be reusable by moving
+    // it within the panel. Rows that weren't damaged still match their
+    // signature.
+    int scroll = 0;
+    // Moved rows would keep the raster colors of their old position.
+    if (changed_rows && valid_row_signatures_ == kAllRows &&
+        raster_index_ == kNoRaster) {
+      for (size_t row = 0; row < Display::kHeight; row++) {
+        if (!(checked_rows & (1ull << row)))
+          signatures[row] = row_signatures_[row];
+      }
+      checked_rows = kAllRows;
+      scroll = FindScroll(signatures, changed_rows);
+    }
+    if (scroll) {
+      AddScrollCommands(scroll);
+      // Rows that didn't match have to be sent in full, but only those.
+      ScrollDamage(scroll, signatures, damage_, changed_rows);
+    }
+    changed_rows = AddFillCommands(changed_rows);
+  }
+
+  for (size_t row = 0; row < Display::kHeight; row++) {
+    if (checked_rows & (1ull << row))
+      row_signatures_[row] = signatures[row];
+  }
+  valid_row_signatures_ |= checked_rows;
+
+  // Scan out the runs of changed rows within each damaged rectangle.
+  scan_rects_.Clear();
+  AddScanRects(damage_, changed_rows, scan_rects_);
+  damage_.Clear();
+
+  scan_rect_index_ = 0;
+  if (scan_rects_.count) {
+    const auto& rect = scan_rects_.rects[0];
+    scan_row_ = rect.y0;
+    if (raster_index_ != kNoRaster)
+      ApplyRasterColor(scan_row_);
+    BeginScanRow(scan_row_, rect.x0, rect.x1);
+  }
+}
+
+void IRAM_ATTR RainbowFX::NextScanRow() {
+  if (++scan_row_ == scan_rects_.rects[scan_rect_index_].y1) {
+    if (++scan_rect_index_ == scan_rects_.count)
+      return;
+    scan_row_ = scan_rects_.rects[scan_rect_index_].y0;
+  }
+  if (raster_index_ != kNoRaster)
+    ApplyRasterColor(scan_row_);
+  const auto& rect = scan_rects_.rects[scan_rect_index_];
+  BeginScanRow(scan_row_, rect.x0, rect.x1);
+}
+
+void IRAM_ATTR RainbowFX::BeginScanRow(size_t row, uint8_t x0, uint8_t x1) {
+  render_column_ = x0;
+  if (!background_layer_) {
+    backbuffer_ptr_ = &backbuffer_pixels_[(row * kWidth + x0) * kSuperSampling *
+                                          kBackbufferBitsPerPixel / 8];
+    return;
+  }
+  // A word of each backbuffer line is four display pixels, and two bytes of
+  // the background layer, whose pixels each cover a 2x2 block.
+  constexpr size_t kLineWords = kWidth * kBackbufferBitsPerPixel / 32;
+  const uint32_t* src = RowWords(row);
+  const uint8_t* background = BackgroundRow(row);
+  auto* dest = reinterpret_cast<uint32_t*>(composite_lines_.data());
+  for (size_t i = x0 / 4; i < (x1 + 3u) / 4; i++) {
+    uint32_t top = src[i];
+    uint32_t bottom = src[i + kLineWords];
+    uint32_t under = DoubleNibbles(LoadNibbles(background + 2 * i, 2));
+    if (under) {
+      top = BlendNibbles(top, under, ~OpaqueMask(top));
+      bottom = BlendNibbles(bottom, under, ~OpaqueMask(bottom));
+    }
+    dest[i] = top;
+    dest[i + kLineWords] = bottom;
+  }
+  backbuffer_ptr_ = &composite_lines_[x0];
+}
+
+void IRAM_ATTR RainbowFX::AddScanRects(const DamageList& damage,
+                                       uint64_t rows,
+                                       DamageList& scan_rects) {
+  for (size_t i = 0; i < damage.count; i++) {
+    const auto& rect = damage.rects[i];
+    for (uint8_t y0 = rect.y0; y0 < rect.y1;) {
+      if (!(rows & (1ull << y0))) {
+        y0++;
+        continue;
+      }
+      uint8_t y1 = y0 + 1;
+      while (y1 < rect.y1 && (rows & (1ull << y1)))
+        y1++;
+      scan_rects.Add(Display::Rect{rect.x0, y0, rect.x1, y1});
+      y0 = y1;
+    }
+  }
+}
+
+uint32_t RainbowFX::scan_pixel_count() const {
+  return scan_rects_.area();
 }
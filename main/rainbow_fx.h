@@ -1,7 +1,13 @@
 #pragma once
 
+#include <array>
+#include <type_traits>
+
+#include "asset_cache.h"
 #include "display.h"
+#include "nibble.h"
 #include "sprites.h"
+#include "sprites_compiled.h"
 
 struct Glyph;
 struct Sprite;
@@ -14,52 +20,371 @@ class RainbowFX {
   static constexpr auto kWidth = Display::kWidth * kSuperSampling;
   static constexpr auto kHeight = Display::kHeight * kSuperSampling;
 
+  // How supersampled backbuffer pixels are resolved into display pixels.
+  enum class ResolveKernel {
+    // Four palette lookups per output pixel.
+    kPalette,
+    // Two lookups per output pixel from a table of summed palette colors for
+    // every possible backbuffer byte (i.e., pair of pixels).
+    kPairSum,
+  };
+  static constexpr ResolveKernel kResolveKernel = ResolveKernel::kPairSum;
+
+  // How glyphs are rasterized into the backbuffer.
+  enum class GlyphKernel {
+    // Tests every bit of the 1bpp glyph bitmap.
+    kBits,
+    // Fills the horizontal runs of set pixels on each row in bulk.
+    kSpans,
+  };
+  static constexpr GlyphKernel kGlyphKernel = GlyphKernel::kSpans;
+
+  // Whether BeginRender() may replace pixel data with panel copy and fill
+  // commands when the contents scroll vertically or rows are a solid color.
+  static constexpr bool kHardwareAcceleration = true;
+
+  // Whether DrawSprite() uses the routines in sprites_compiled.h for the
+  // sprites that have them, unless the sprite is clipped horizontally.
+  static constexpr bool kDrawCompiledSprites = true;
+
+  // Whether the background layer (see ScrollBackground()) is composited
+  // under the backbuffer at scan-out.
+  static constexpr bool kBackgroundLayer = true;
+
   RainbowFX();
   ~RainbowFX();
 
-  void BeginRender();
-  void Render(uint32_t* pixels);
+  // Prepares the scan-out of the regions that changed since the previous
+  // scan-out, or of the whole screen if |full_frame| is set. commands() must be
+  // executed on the panel before the scan-out.
+  void BeginRender(bool full_frame = false);
+  // Resolves the next |count| pixels of the scan-out into |pixels|, in the
+  // format of the color mode set with SetColorMode().
+  template <ResolveKernel kKernel = kResolveKernel>
+  void Render(uint32_t* pixels, size_t count);
+  // As above, in the format of |kColorMode|.
+  template <ResolveKernel kKernel, Display::ColorMode kColorMode>
+  void Render(uint32_t* pixels, size_t count);
+
+  // Rectangles that BeginRender() selected for scan-out.
+  const Display::Rect* scan_rects() const { return scan_rects_.rects.data(); }
+  size_t scan_rect_count() const { return scan_rects_.count; }
+  uint32_t scan_pixel_count() const;
 
+  // Commands that BeginRender() selected to run on the panel before the
+  // scan-out.
+  const Display::DrawCommand* commands() const { return commands_.data(); }
+  size_t command_count() const { return command_count_; }
+
+  void set_hardware_acceleration(bool enabled) {
+    hardware_acceleration_ = enabled;
+  }
+  void set_compiled_sprites(bool enabled) { compiled_sprites_ = enabled; }
+  void set_background_layer(bool enabled);
+  // Switches |display| to |mode|, and Render() to produce pixels in it. In
+  // that mode BeginRender() also weighs sending pixel data against panel
+  // commands.
+  void SetColorMode(Display* display, Display::ColorMode mode) {
+    display->SetColorMode(mode);
+    color_mode_ = mode;
+  }
+  Display::ColorMode color_mode() const { return color_mode_; }
+  bool background_layer() const { return background_layer_; }
+
+  // Forces the next scan-out to cover the whole screen, e.g., if the panel
+  // contents were lost.
+  void Invalidate();
+
+  // Clears the backbuffer, but not the background layer.
   void Clear();
-  void Fade();
+
+  // The background layer: a 4bpp pixel per display pixel, which shows
+  // through the zero pixels of the backbuffer and persists across Clear().
+  // It wraps around vertically, so a scroll only takes drawing the rows that
+  // came into view.
+  //
+  // Scrolls the layer so that background row |top| is at the top of the
+  // screen. The rows that came into view are cleared, to be drawn with
+  // DrawBackgroundSprite() before the next BeginRender().
+  void ScrollBackground(int top);
+  // Blends |sprite| onto the rows of the layer that came into view, at
+  // backbuffer column |x| and background row |y|, i.e., at the size of a
+  // kScale2x sprite. Does nothing if no rows came into view.
+  void DrawBackgroundSprite(const Sprite& sprite, int x, int y);
+
+  // Interpolates the palette set by SetPalette() and the animation calls
+  // below towards |target_rgb| by |amount| / 255, until the next fade; 0
+  // restores it. Like SetPalette(), this only changes 16 colors instead of the
+  // pixels, and takes effect at the next BeginRender().
+  void FadePalette(uint8_t amount, uint32_t target_rgb = 0);
+  // Sets the palette, in exploded RGB565, for the next BeginRender(), and ends
+  // any fade. The palette in use by the current scan-out isn't affected.
+  void SetPalette(const std::array<uint32_t, 16>& palette);
+
+  // Palette animation. These edit the palette for the next BeginRender(),
+  // which stays faded if it was.
+  //
+  // Rotates entries |first| to |last| (inclusive) up by one, e.g., once per
+  // frame for color cycling.
+  void CyclePalette(uint8_t first, uint8_t last);
+  // Sets entries |first| to |last| (inclusive) to a gradient between two
+  // colors.
+  void GradientPalette(uint8_t first,
+                       uint8_t last,
+                       uint32_t first_rgb,
+                       uint32_t last_rgb);
+
+  // Overrides palette entry |index| on each display row with |colors|, in
+  // exploded RGB565, from the next BeginRender() on. The entry is switched
+  // as the scan-out reaches each row, so gradients and color bars don't touch
+  // the backbuffer. Only rows whose color changed are sent again.
+  void SetRasterColors(uint8_t index,
+                       const std::array<uint32_t, Display::kHeight>& colors);
+  void ClearRasterColors();
+
   void Move(int16_t delta);
+  template <GlyphKernel kKernel = kGlyphKernel>
   const Glyph* DrawGlyph(uint8_t glyph, int x, int y);
   void MeasureText(const char*, uint16_t& w, uint16_t& h);
 
+  // Draws |text| at (x, y), stopping at the first character without a glyph.
+  void DrawText(const char* text, int x, int y);
+
+  const AssetCache::Stats& asset_cache_stats() const {
+    return asset_cache_.stats();
+  }
+
   struct DefaultDrawTraits {
     static constexpr bool kBlend = false;
+    static constexpr bool kSpans = false;
     static constexpr bool kScale2x = kSuperSampling == 2;
   };
   struct BlendDrawTraits {
     static constexpr bool kBlend = true;
+    static constexpr bool kSpans = false;
     static constexpr bool kScale2x = kSuperSampling == 2;
   };
   struct BlendDrawTraits1X {
     static constexpr bool kBlend = true;
+    static constexpr bool kSpans = false;
+    static constexpr bool kScale2x = false;
+  };
+  // Blends using the run-length encoded sprite data, which skips transparent
+  // runs and copies opaque ones without testing each pixel.
+  struct SpanDrawTraits {
+    static constexpr bool kBlend = true;
+    static constexpr bool kSpans = true;
+    static constexpr bool kScale2x = kSuperSampling == 2;
+  };
+  struct SpanDrawTraits1X {
+    static constexpr bool kBlend = true;
+    static constexpr bool kSpans = true;
     static constexpr bool kScale2x = false;
   };
   template <typename DrawTraits = DefaultDrawTraits>
   void DrawSprite(const Sprite& sprite, int x, int y);
 
  private:
+  // Composes its rows with the same kernels.
+  friend class BeamFX;
+
+  static constexpr size_t kMaxDamageRects = 4;
+  static constexpr size_t kMaxCommands = 16;
+  // How far to look for a vertical scroll of the previous scan-out.
+  static constexpr int kMaxScrollRows = 16;
+  static constexpr uint64_t kAllRows = ~0ull >> (64 - Display::kHeight);
+  static constexpr size_t kBackgroundLineBytes = Display::kWidth / 2;
+  static_assert((Display::kHeight & (Display::kHeight - 1)) == 0,
+                "The background layer wraps around by masking");
+  static_assert(!kBackgroundLayer || kSuperSampling == 2,
+                "The background layer needs 2x supersampling");
+
+  // A few rectangles in display coordinates. When full, a new rectangle is
+  // merged into the one that grows the least.
+  struct DamageList {
+    std::array<Display::Rect, kMaxDamageRects> rects;
+    uint8_t count = 0;
+
+    void Add(const Display::Rect& rect);
+    void Add(const DamageList& other);
+    void Clear() { count = 0; }
+    uint32_t area() const;
+  };
+
+  // Records a change to the backbuffer rectangle from (x0, y0) to (x1, y1),
+  // exclusive.
+  void Damage(int x0, int y0, int x1, int y1);
+  template <bool kScale2x>
+  void DrawSpriteSpans(const Sprite& sprite,
+                       int pos_x,
+                       int pos_y,
+                       int skip_rows,
+                       int width,
+                       int height);
+  // Draws |count| bytes of sprite pixels to |dest|, skipping transparent
+  // (zero) pixels if |kBlend| is set.
+  template <bool kBlend, bool kScale2x>
+  static void DrawSpriteRow(uint8_t* dest, const uint8_t* src, int count);
+  template <bool kBlend, bool kScale2x>
+  static void DrawSpriteWord(uint8_t* dest, uint32_t pixels, size_t bytes);
+  // Draws one row of run-length encoded sprite data to |dest|, up to
+  // |width_bytes| bytes of sprite pixels, and returns the next row.
+  template <bool kScale2x>
+  static const uint8_t* DrawSpanRow(uint8_t* dest,
+                                    const uint8_t* spans,
+                                    int width_bytes);
+  static const uint8_t* SkipSpanRow(const uint8_t* spans);
+  // The line of the background layer holding background row |row|, and the
+  // index and contents of the one shown on display row |row|.
+  uint8_t* BackgroundLine(int row) {
+    return &background_pixels_[(row & (Display::kHeight - 1)) *
+                               kBackgroundLineBytes];
+  }
+  size_t BackgroundRowIndex(size_t row) const {
+    return (background_top_ + row) & (Display::kHeight - 1);
+  }
+  const uint8_t* BackgroundRow(size_t row) const {
+    return &background_pixels_[BackgroundRowIndex(row) *
+                               kBackgroundLineBytes];
+  }
+  // Blends |count| 4bpp pixels from |src| onto |line| at display |column|.
+  static void DrawBackgroundPixels(uint8_t* line,
+                                   int column,
+                                   const uint8_t* src,
+                                   int count);
+  static void FillSpan(uint8_t* dest, size_t start, size_t end);
+  const uint32_t* RowWords(size_t row) const;
+  // Recomputes the signatures of the background lines and backbuffer rows
+  // that may have changed since the last BeginRender().
+  void UpdateSignatures();
+  uint32_t RowSignature(size_t row) const;
+  bool UniformRow(size_t row, uint8_t& color) const;
+  // Sets |pending_palette_| to |base_palette_| faded.
+  void ApplyFade();
+  void CommitPalette();
+  void CommitRasterColors();
+  void ApplyRasterColor(size_t row);
+  // Bytes of pixel data for |pixels| display pixels in the panel's color mode.
+  int PixelBytes(int pixels) const {
+    return pixels * Display::BitsPerPixel(color_mode_) / 8;
+  }
+  int FindScroll(const std::array<uint32_t, Display::kHeight>& signatures,
+                 uint64_t changed_rows) const;
+  // Sets |damage| to the rows that don't match the row |scroll| moves there,
+  // and |rows| to their mask.
+  void ScrollDamage(int scroll,
+                    const std::array<uint32_t, Display::kHeight>& signatures,
+                    DamageList& damage,
+                    uint64_t& rows) const;
+  // Number of copy commands AddScrollCommands() uses for |scroll|.
+  static size_t ScrollCopies(int scroll);
+  void AddScrollCommands(int scroll);
+  uint64_t AddFillCommands(uint64_t changed_rows);
+  // Adds the runs of |rows| within each rectangle of |damage| to |scan_rects|.
+  static void AddScanRects(const DamageList& damage,
+                           uint64_t rows,
+                           DamageList& scan_rects);
+  void NextScanRow();
+  // Points the scan-out at columns [x0, x1) of display row |row|, composited
+  // over the background layer into |composite_lines_| if it is enabled.
+  void BeginScanRow(size_t row, uint8_t x0, uint8_t x1);
+  template <ResolveKernel kKernel>
+  void ResolveSpan(uint32_t* pixels, size_t count);
+  template <ResolveKernel kKernel>
+  void ResolveSpan(uint16_t* pixels, size_t count);
+
   // The backbuffer is 4 bits per pixel (paletted).
   std::array<uint8_t, kWidth * kHeight * kBackbufferBitsPerPixel / 8>
       backbuffer_pixels_ __attribute__((aligned)) = {};
 
+  // Sum of the exploded palette colors of both pixels in a backbuffer byte.
+  std::array<uint32_t, 256> pair_sums_;
+
+  // The palette used by the scan-out, with the raster color of the current
+  // row applied, and the one BeginRender() switches to if |palette_changed_|
+  // is set.
+  std::array<uint32_t, 16> palette_;
+  std::array<uint32_t, 16> pending_palette_;
+  bool palette_changed_ = false;
+  // |pending_palette_| before FadePalette() applies the fade.
+  std::array<uint32_t, 16> base_palette_;
+  uint8_t fade_amount_ = 0;
+  uint32_t fade_target_ = 0;
+
+  // Per-row colors of palette entry |raster_index_|, or kNoRaster, likewise
+  // for the scan-out and for the next BeginRender().
+  static constexpr uint8_t kNoRaster = 0xff;
+  uint8_t raster_index_ = kNoRaster;
+  uint8_t pending_raster_index_ = kNoRaster;
+  bool raster_changed_ = false;
+  std::array<uint32_t, Display::kHeight> raster_colors_;
+  std::array<uint32_t, Display::kHeight> pending_raster_colors_;
+
+  // The background layer, as a ring of display rows, and the background row
+  // at the top of the screen. |background_valid_| is set once the rows in
+  // view have been drawn; rows [background_first_, background_last_) came
+  // into view since the last BeginRender().
+  std::array<uint8_t, kBackgroundLineBytes * Display::kHeight>
+      background_pixels_ __attribute__((aligned)) = {};
+  // Signature of each line of the layer, recomputed by BeginRender() for the
+  // lines set in |stale_background_signatures_|.
+  std::array<uint32_t, Display::kHeight> background_signatures_;
+  uint64_t stale_background_signatures_ = kAllRows;
+  bool background_layer_ = kBackgroundLayer;
+  bool background_valid_ = false;
+  bool background_moved_ = false;
+  int background_top_ = 0;
+  int background_first_ = 0;
+  int background_last_ = 0;
+
+  AssetCache asset_cache_;
+
+  // Regions changed since the last scan-out, and regions drawn to since the
+  // last Clear() (i.e., everything that may be non-zero).
+  DamageList damage_;
+  DamageList drawn_;
+
+  // Signature of each display row's contents as of the last scan-out.
+  // Damaged rows whose signature didn't change aren't sent again. It combines
+  // the signatures of the backbuffer row, which BeginRender() recomputes for
+  // damaged rows, and of the background layer line.
+  std::array<uint32_t, Display::kHeight> row_signatures_ = {};
+  std::array<uint32_t, Display::kHeight> backbuffer_signatures_ = {};
+  uint64_t valid_row_signatures_ = 0;
+  static_assert(Display::kHeight <= 64, "Row signature mask too small");
+
+  bool hardware_acceleration_ = kHardwareAcceleration;
+  bool compiled_sprites_ = kDrawCompiledSprites;
+  Display::ColorMode color_mode_ = Display::kColorMode;
+  std::array<Display::DrawCommand, kMaxCommands> commands_;
+  uint8_t command_count_ = 0;
+
+  DamageList scan_rects_;
+  uint8_t scan_rect_index_ = 0;
+  uint8_t scan_row_ = 0;
+
   const uint8_t* backbuffer_ptr_ = nullptr;
+  std::array<uint8_t, kWidth> composite_lines_ __attribute__((aligned));
   uint8_t render_column_ = 0;
 };
 
+static_assert(kCompiledSpriteLineBytes ==
+                  RainbowFX::kWidth * RainbowFX::kBackbufferBitsPerPixel / 8,
+              "sprites_compiled.h was generated for another backbuffer size");
+static_assert(sizeof(kCompiledSprites) / sizeof(kCompiledSprites[0]) ==
+                  sizeof(kSprites) / sizeof(kSprites[0]),
+              "sprites_compiled.h is out of date");
+
 template <typename DrawTraits>
 void IRAM_ATTR RainbowFX::DrawSprite(const Sprite& sprite,
                                      int pos_x,
                                      int pos_y) {
-  const uint8_t* sprite_bits = &kSpriteData[sprite.offset];
   int width = sprite.width;
   int height = sprite.height;
+  int skip_rows = 0;
   if (pos_y < 0) {
-    sprite_bits += -pos_y * (sprite.width / 2);
-    height -= -pos_y;
+    skip_rows = -pos_y;
+    height -= skip_rows;
     pos_y = 0;
   }
   if (DrawTraits::kScale2x) {
@@ -71,50 +396,149 @@ void IRAM_ATTR RainbowFX::DrawSprite(const Sprite& sprite,
       height = kHeight - pos_y;
     }
   }
-  if (height < 0)
+  // Clip against the right edge so that the sprite doesn't wrap around to the
+  // next row (or past the end of the backbuffer).
+  int max_width =
+      (kWidth - (pos_x & ~1)) / (DrawTraits::kScale2x ? 2 : 1) & ~1;
+  if (width > max_width)
+    width = max_width;
+  if (height <= 0 || width <= 0)
+    return;
+  if (DrawTraits::kScale2x) {
+    Damage(pos_x, 2 * pos_y, pos_x + 2 * width, 2 * (pos_y + height));
+  } else {
+    Damage(pos_x, pos_y, pos_x + width, pos_y + height);
+  }
+  constexpr int kCompiledVariant =
+      DrawTraits::kScale2x ? (DrawTraits::kBlend ? kCompiledBlend
+                                                 : kCompiledDefault)
+                           : (DrawTraits::kBlend ? kCompiledBlend1X : -1);
+  if (kCompiledVariant >= 0 && compiled_sprites_ && width == sprite.width) {
+    const auto& compiled = kCompiledSprites[sprite.index][kCompiledVariant];
+    uint8_t* dest = &backbuffer_pixels_[(pos_y * kWidth + pos_x) / 2];
+    if (DrawTraits::kScale2x)
+      dest = &backbuffer_pixels_[(2 * pos_y * kWidth + pos_x) / 2];
+    auto routine = compiled.routines[reinterpret_cast<uintptr_t>(dest) & 3];
+    if (routine) {
+      routine(dest, skip_rows, skip_rows + height);
+      return;
+    }
+  }
+  if (DrawTraits::kSpans) {
+    DrawSpriteSpans<DrawTraits::kScale2x>(sprite, pos_x, pos_y, skip_rows,
+                                          width, height);
     return;
-  for (size_t y = 0; y < height; y++) {
+  }
+  const uint8_t* sprite_bits =
+      asset_cache_.Get(&kSpriteData[sprite.offset / 4],
+                       sprite.width / 2 * sprite.height) +
+      skip_rows * (sprite.width / 2);
+  for (int y = 0; y < height; y++) {
     uint8_t* dest = &backbuffer_pixels_[((pos_y + y) * kWidth + pos_x) / 2];
     if (DrawTraits::kScale2x) {
       dest = &backbuffer_pixels_[(2 * (pos_y + y) * kWidth + pos_x) / 2];
     }
-    for (size_t x = 0; x < width; x += 2) {
-      if (DrawTraits::kBlend) {
-        uint8_t p0 = *sprite_bits & 0x0f;
-        uint8_t p1 = *sprite_bits & 0xf0;
-        if (p0) {
-          *dest &= 0xf0;
-          *dest |= p0;
-        }
-        if (p1) {
-          *dest &= 0x0f;
-          *dest |= p1;
-        }
-      } else {
-        *dest = *sprite_bits;
-      }
-      if (DrawTraits::kScale2x) {
-        uint8_t p0 = *dest & 0x0f;
-        uint8_t p1 = *dest & 0xf0;
-        p0 |= p0 << 4;
-        p1 |= p1 >> 4;
-        dest[0] = p0;
-        dest[(kWidth / 2)] = p0;
-        dest[1] = p1;
-        dest[(kWidth / 2) + 1] = p1;
-        dest += 2;
-      } else {
-        dest++;
-      }
-      sprite_bits++;
+    DrawSpriteRow<DrawTraits::kBlend, DrawTraits::kScale2x>(dest, sprite_bits,
+                                                            width / 2);
+    sprite_bits += sprite.width / 2;
+  }
+}
+
+template <bool kBlend, bool kScale2x>
+__attribute__((always_inline)) inline void RainbowFX::DrawSpriteWord(
+    uint8_t* dest,
+    uint32_t pixels,
+    size_t bytes) {
+  // Only the first |bytes| bytes of |pixels| are drawn.
+  uint32_t mask = kBlend ? OpaqueMask(pixels) : ~0u >> (32 - 8 * bytes);
+  if (kBlend && !mask)
+    return;
+  if (!kScale2x) {
+    uint32_t word = LoadNibbles(dest, bytes);
+    StoreNibbles(dest, BlendNibbles(word, pixels, mask), bytes);
+    return;
+  }
+  // Each half becomes a word, which is drawn to two rows.
+  for (size_t half = 0; half < 2 && 2 * half < bytes; half++) {
+    size_t half_bytes = 2 * std::min<size_t>(bytes - 2 * half, 2);
+    uint32_t doubled = DoubleNibbles(pixels >> (16 * half));
+    uint32_t doubled_mask = DoubleNibbles(mask >> (16 * half));
+    uint8_t* d = dest + 4 * half;
+    for (size_t row = 0; row < 2; row++, d += kWidth / 2) {
+      uint32_t word = LoadNibbles(d, half_bytes);
+      StoreNibbles(d, BlendNibbles(word, doubled, doubled_mask), half_bytes);
     }
   }
 }
 
+template <bool kBlend, bool kScale2x>
+void IRAM_ATTR RainbowFX::DrawSpriteRow(uint8_t* dest,
+                                        const uint8_t* src,
+                                        int count) {
+  // A word at a time, then the remaining bytes one at a time.
+  constexpr size_t kScale = kScale2x ? 2 : 1;
+  for (; count >= 4; count -= 4, src += 4, dest += 4 * kScale)
+    DrawSpriteWord<kBlend, kScale2x>(dest, LoadNibbles(src), 4);
+  for (; count > 0; count--, src++, dest += kScale)
+    DrawSpriteWord<kBlend, kScale2x>(dest, *src, 1);
+}
+
+template <bool kScale2x>
+void IRAM_ATTR RainbowFX::DrawSpriteSpans(const Sprite& sprite,
+                                          int pos_x,
+                                          int pos_y,
+                                          int skip_rows,
+                                          int width,
+                                          int height) {
+  // See encode_spans() in sprites2c.py for the format.
+  const uint8_t* spans = asset_cache_.Get(
+      &kSpriteSpanData[sprite.span_offset / 4], sprite.span_size);
+  while (skip_rows--)
+    spans = SkipSpanRow(spans);
+
+  for (int y = 0; y < height; y++) {
+    uint8_t* dest = &backbuffer_pixels_[((pos_y + y) * kWidth + pos_x) / 2];
+    if (kScale2x) {
+      dest = &backbuffer_pixels_[(2 * (pos_y + y) * kWidth + pos_x) / 2];
+    }
+    spans = DrawSpanRow<kScale2x>(dest, spans, width / 2);
+  }
+}
+
+inline const uint8_t* RainbowFX::SkipSpanRow(const uint8_t* spans) {
+  while (spans[1])
+    spans += 2 + (spans[1] & 0x7f);
+  return spans + 2;
+}
+
+template <bool kScale2x>
+__attribute__((always_inline)) inline const uint8_t* RainbowFX::DrawSpanRow(
+    uint8_t* dest,
+    const uint8_t* spans,
+    int width_bytes) {
+  int x = 0;
+  while (uint8_t count = spans[1]) {
+    x += spans[0];
+    spans += 2;
+    bool masked = count & 0x80;
+    count &= 0x7f;
+    int visible = std::min<int>(count, width_bytes - x);
+    uint8_t* d = dest + (kScale2x ? 2 * x : x);
+    if (masked) {
+      DrawSpriteRow<true, kScale2x>(d, spans, visible);
+    } else {
+      DrawSpriteRow<false, kScale2x>(d, spans, visible);
+    }
+    spans += count;
+    x += count;
+  }
+  return spans + 2;
+}
+
 #include "util.h"
 
 // clang-format off
-// Based on https://lospec.com/palette-list/sweetie-16
+// The default palette. Based on https://lospec.com/palette-list/sweetie-16
 static constexpr std::array<uint32_t, 16> kPalette = {
   ExplodeRGB565(PackRGB565(0x1a1c2c * 0)),
   ExplodeRGB565(PackRGB565(0x5d275d)),
@@ -135,41 +559,59 @@ static constexpr std::array<uint32_t, 16> kPalette = {
 };
 // clang-format on
 
-__attribute__((always_inline)) inline void RainbowFX::Render(uint32_t* pixels) {
+template <RainbowFX::ResolveKernel kKernel>
+__attribute__((always_inline)) inline void RainbowFX::ResolveSpan(
+    uint32_t* pixels,
+    size_t count) {
   if (kSuperSampling == 1) {
-    for (size_t i = 0; i < Display::kRenderBatchPixels *
-                               Display::kBitsPerPixel / (sizeof(uint32_t) * 8);
-         i++) {
+    for (size_t i = 0; i < count / 2; i++) {
       // Each backbuffer byte expands into two 16 bit pixels.
       uint8_t pair = *backbuffer_ptr_++;
-      uint16_t p0 = UnexplodeRGB565(kPalette[pair & 0b00001111]);
-      uint16_t p1 = UnexplodeRGB565(kPalette[(pair & 0b11110000) >> 4]);
+      uint16_t p0 = UnexplodeRGB565(palette_[pair & 0b00001111]);
+      uint16_t p1 = UnexplodeRGB565(palette_[(pair & 0b11110000) >> 4]);
       p0 = __builtin_bswap16(p0);
       p1 = __builtin_bswap16(p1);
       *pixels++ = p0 | (p1 << 16);
     }
+  } else if (kSuperSampling == 2 && kKernel == ResolveKernel::kPairSum) {
+    const uint8_t* top = backbuffer_ptr_;
+    const uint8_t* bottom = backbuffer_ptr_ + kWidth / 2;
+    for (size_t i = 0; i < count / 2; i++) {
+      // Each backbuffer byte holds two horizontally adjacent pixels, so the
+      // 2x2 block for one output pixel is one byte from each row.
+      uint32_t s0 = pair_sums_[top[0]] + pair_sums_[bottom[0]];
+      uint32_t s1 = pair_sums_[top[1]] + pair_sums_[bottom[1]];
+      top += 2;
+      bottom += 2;
+
+      uint16_t b0 = UnexplodeRGB565(s0 >> 2);
+      uint16_t b1 = UnexplodeRGB565(s1 >> 2);
+
+      b0 = __builtin_bswap16(b0);
+      b1 = __builtin_bswap16(b1);
+      *pixels++ = b0 | (b1 << 16);
+    }
+    backbuffer_ptr_ = top;
   } else if (kSuperSampling == 2) {
-    for (size_t i = 0; i < Display::kRenderBatchPixels *
-                               Display::kBitsPerPixel / (sizeof(uint32_t) * 8);
-         i++) {
+    for (size_t i = 0; i < count / 2; i++) {
       uint8_t pair;
       // Each backbuffer byte expands into two 16 bit pixels. Combine 4
       // backbuffer pixels into one output pixel.
       pair = *backbuffer_ptr_;
-      uint32_t p0 = kPalette[pair & 0b00001111];
-      uint32_t p1 = kPalette[(pair & 0b11110000) >> 4];
+      uint32_t p0 = palette_[pair & 0b00001111];
+      uint32_t p1 = palette_[(pair & 0b11110000) >> 4];
 
       pair = *(backbuffer_ptr_++ + kWidth / 2);
-      uint32_t p2 = kPalette[pair & 0b00001111];
-      uint32_t p3 = kPalette[(pair & 0b11110000) >> 4];
+      uint32_t p2 = palette_[pair & 0b00001111];
+      uint32_t p3 = palette_[(pair & 0b11110000) >> 4];
 
       pair = *backbuffer_ptr_;
-      uint32_t p4 = kPalette[pair & 0b00001111];
-      uint32_t p5 = kPalette[(pair & 0b11110000) >> 4];
+      uint32_t p4 = palette_[pair & 0b00001111];
+      uint32_t p5 = palette_[(pair & 0b11110000) >> 4];
 
       pair = *(backbuffer_ptr_++ + kWidth / 2);
-      uint32_t p6 = kPalette[pair & 0b00001111];
-      uint32_t p7 = kPalette[(pair & 0b11110000) >> 4];
+      uint32_t p6 = palette_[pair & 0b00001111];
+      uint32_t p7 = palette_[(pair & 0b11110000) >> 4];
 
       uint16_t b0 = UnexplodeRGB565((p0 + p1 + p2 + p3) >> 2);
       uint16_t b1 = UnexplodeRGB565((p4 + p5 + p6 + p7) >> 2);
@@ -178,11 +620,52 @@ __attribute__((always_inline)) inline void RainbowFX::Render(uint32_t* pixels) {
       b1 = __builtin_bswap16(b1);
       *pixels++ = b0 | (b1 << 16);
     }
+  }
+}
 
-    render_column_ += Display::kRenderBatchPixels;
-    if (render_column_ >= Display::kWidth) {
-      backbuffer_ptr_ += kWidth * kBackbufferBitsPerPixel / 8;
-      render_column_ = 0;
-    }
+template <RainbowFX::ResolveKernel kKernel>
+__attribute__((always_inline)) inline void RainbowFX::ResolveSpan(
+    uint16_t* pixels,
+    size_t count) {
+  static_assert(kSuperSampling == 2, "RGB332 needs 2x supersampling");
+  // Always uses the pair sums; the 2x2 average is reduced straight to RGB332.
+  const uint8_t* top = backbuffer_ptr_;
+  const uint8_t* bottom = backbuffer_ptr_ + kWidth / 2;
+  for (size_t i = 0; i < count / 2; i++) {
+    uint32_t s0 = pair_sums_[top[0]] + pair_sums_[bottom[0]];
+    uint32_t s1 = pair_sums_[top[1]] + pair_sums_[bottom[1]];
+    top += 2;
+    bottom += 2;
+    *pixels++ = UnexplodeRGB332(s0 >> 2) | (UnexplodeRGB332(s1 >> 2) << 8);
+  }
+  backbuffer_ptr_ = top;
+}
+
+template <RainbowFX::ResolveKernel kKernel>
+__attribute__((always_inline)) inline void RainbowFX::Render(uint32_t* pixels,
+                                                             size_t count) {
+  if (color_mode_ == Display::COLOR_MODE_256)
+    Render<kKernel, Display::COLOR_MODE_256>(pixels, count);
+  else
+    Render<kKernel, Display::COLOR_MODE_65K>(pixels, count);
+}
+
+template <RainbowFX::ResolveKernel kKernel, Display::ColorMode kColorMode>
+__attribute__((always_inline)) inline void RainbowFX::Render(uint32_t* pixels,
+                                                             size_t count) {
+  // A pixel pair is 32 bits in 65k color mode and 16 bits in 256 color mode.
+  using PixelPair =
+      typename std::conditional<kColorMode == Display::COLOR_MODE_256,
+                                uint16_t, uint32_t>::type;
+  PixelPair* pairs = reinterpret_cast<PixelPair*>(pixels);
+  while (count) {
+    const auto& rect = scan_rects_.rects[scan_rect_index_];
+    size_t span = std::min<size_t>(count, rect.x1 - render_column_);
+    ResolveSpan<kKernel>(pairs, span);
+    pairs += span / 2;
+    count -= span;
+    render_column_ += span;
+    if (render_column_ == rect.x1)
+      NextScanRow();
   }
 }
@@ -0,0 +1,90 @@
+#include "register_shadow.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "i2c_transaction.h"
+
+RegisterShadow::Stats RegisterShadow::stats_;
+
+RegisterShadow::RegisterShadow(uint16_t first, uint16_t end)
+    : first_(first), end_(end) {
+  static_assert(kMaxRegisters % 32 == 0, "Bit sets must fill their words");
+  assert(end > first && end - first <= kMaxRegisters);
+}
+
+void RegisterShadow::SetVolatile(uint16_t reg) {
+  if (reg >= first_ && reg < end_)
+    Set(volatile_, reg - first_);
+}
+
+void RegisterShadow::Clear() {
+  memset(known_, 0, sizeof(known_));
+}
+
+bool RegisterShadow::IsShadowed(uint16_t reg) const {
+  return reg >= first_ && reg < end_ && !Test(volatile_, reg - first_);
+}
+
+bool RegisterShadow::IsKnown(uint16_t reg) const {
+  return IsShadowed(reg) && Test(known_, reg - first_);
+}
+
+bool RegisterShadow::Read(uint16_t reg, uint8_t* data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    if (!IsKnown(reg + i))
+      return false;
+  }
+  memcpy(data, values_ + (reg - first_), size);
+  stats_.reads_avoided++;
+  stats_.bytes_avoided += size;
+  return true;
+}
+
+bool RegisterShadow::Write(uint16_t reg, const uint8_t* data, size_t size) {
+  bool unchanged = true;
+  for (size_t i = 0; i < size; i++) {
+    uint16_t r = reg + i;
+    if (!IsShadowed(r)) {
+      unchanged = false;
+      continue;
+    }
+    if (!Test(known_, r - first_) || values_[r - first_] != data[i]) {
+      unchanged = false;
+      values_[r - first_] = data[i];
+      Set(known_, r - first_);
+    }
+  }
+  if (unchanged) {
+    stats_.writes_avoided++;
+    stats_.bytes_avoided += size;
+  }
+  return !unchanged;
+}
+
+void RegisterShadow::Fill(uint16_t reg, const uint8_t* data, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    uint16_t r = reg + i;
+    if (IsShadowed(r) && !Test(known_, r - first_)) {
+      values_[r - first_] = data[i];
+      Set(known_, r - first_);
+    }
+  }
+}
+
+uint32_t RegisterShadow::Verify(uint8_t address) {
+  uint8_t device[kMaxRegisters];
+  I2CTransaction transaction(address);
+  transaction.Read(first_, device, end_ - first_);
+  if (!transaction.Submit())
+    return 0;
+  uint32_t mismatches = 0;
+  for (uint16_t reg = first_; reg < end_; reg++) {
+    if (IsKnown(reg) && values_[reg - first_] != device[reg - first_]) {
+      values_[reg - first_] = device[reg - first_];
+      mismatches++;
+    }
+  }
+  stats_.mismatches += mismatches;
+  return mismatches;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// A write-through copy of the configuration registers a driver owns, from
+// |first| up to but not including |end|, which the device only changes when
+// told to. A register is known once it's been written or read; reads of
+// known registers can be served from the copy, and writes of the values they
+// already hold dropped. I2CTransaction does both when given a shadow.
+class RegisterShadow {
+ public:
+  static constexpr size_t kMaxRegisters = 128;
+
+  struct Stats {
+    // Accesses served from the copy or dropped.
+    uint32_t reads_avoided = 0;
+    uint32_t writes_avoided = 0;
+    // Register bytes not read or written, not counting the address and
+    // index bytes the accesses would have needed on top.
+    uint32_t bytes_avoided = 0;
+    // Known registers that Verify() found to differ from the device.
+    uint32_t mismatches = 0;
+  };
+
+  RegisterShadow(uint16_t first, uint16_t end);
+
+  RegisterShadow(const RegisterShadow&) = delete;
+  RegisterShadow& operator=(const RegisterShadow&) = delete;
+
+  // Excludes |reg| from the copy, for status registers within the range.
+  void SetVolatile(uint16_t reg);
+  // Forgets all registers, e.g., after a reset or a failed write.
+  void Clear();
+
+  // Copies |size| registers from |reg| on into |data| and returns true if
+  // they're all known.
+  bool Read(uint16_t reg, uint8_t* data, size_t size);
+  // Stores |size| registers from |reg| on being written with |data|. Returns
+  // false if they were known to hold it already, and the write can be
+  // dropped.
+  bool Write(uint16_t reg, const uint8_t* data, size_t size);
+  // Learns registers read from the device, keeping the ones already known,
+  // which a later write in the same transaction may have set.
+  void Fill(uint16_t reg, const uint8_t* data, size_t size);
+
+  // Reads the range from the device at |address| in one burst, and corrects
+  // and counts the known registers that differ. For debugging; allocates.
+  uint32_t Verify(uint8_t address);
+
+  static const Stats& stats() { return stats_; }
+
+ private:
+  // Whether |reg| is in the range and not volatile.
+  bool IsShadowed(uint16_t reg) const;
+  bool IsKnown(uint16_t reg) const;
+
+  static bool Test(const uint32_t* bits, size_t i) {
+    return bits[i / 32] & (1u << (i % 32));
+  }
+  static void Set(uint32_t* bits, size_t i) { bits[i / 32] |= 1u << (i % 32); }
+
+  const uint16_t first_;
+  const uint16_t end_;
+  uint8_t values_[kMaxRegisters] = {};
+  // Bit sets, indexed from |first_|.
+  uint32_t known_[kMaxRegisters / 32] = {};
+  uint32_t volatile_[kMaxRegisters / 32] = {};
+
+  static Stats stats_;
+};
@@ -0,0 +1,84 @@
+#include "scene.h"
+
+#include <esp_system.h>
+#include <stdlib.h>
+
+#include "beam_fx.h"
+#include "font.h"
+#include "native_fx.h"
+#include "rainbow_fx.h"
+#include "sprites.h"
+
+// Draws the two background tiles, |bg_offset| rows down.
+template <typename FX>
+static void IRAM_ATTR DrawBackground(FX& fx, uint32_t bg_offset) {
+  const auto& bg_sprite = kSprites[4];
+  // The background tiles don't overlap, so blending them onto the cleared
+  // backbuffer is the same as copying but skips the transparent parts.
+  fx.template DrawSprite<typename FX::SpanDrawTraits>(
+      bg_sprite, 0, bg_offset % (RainbowFX::kHeight / 2));
+  fx.template DrawSprite<typename FX::SpanDrawTraits>(
+      bg_sprite, RainbowFX::kWidth / 2 - bg_sprite.width,
+      bg_offset % (RainbowFX::kHeight / 2) - RainbowFX::kHeight / 2);
+}
+
+// RainbowFX keeps the tiles in its background layer instead, which only
+// needs the rows that scrolled into view drawn.
+static void IRAM_ATTR DrawBackground(RainbowFX& fx, uint32_t bg_offset) {
+  if (!fx.background_layer()) {
+    DrawBackground<RainbowFX>(fx, bg_offset);
+    return;
+  }
+  const auto& bg_sprite = kSprites[4];
+  // The tiles stay put in background rows, and the view moves up instead.
+  fx.ScrollBackground(-static_cast<int>(bg_offset % (RainbowFX::kHeight / 2)));
+  fx.DrawBackgroundSprite(bg_sprite, 0, 0);
+  fx.DrawBackgroundSprite(bg_sprite, RainbowFX::kWidth / 2 - bg_sprite.width,
+                          -RainbowFX::kHeight / 2);
+}
+
+// The scene is laid out in RainbowFX backbuffer coordinates for either.
+template <typename FX>
+void IRAM_ATTR RenderBackground(FX& fx, uint32_t display_mm) {
+  fx.Clear();
+  DrawBackground(fx, display_mm / 8);
+}
+
+template <typename FX>
+void IRAM_ATTR Render(FX& fx, uint32_t display_mm) {
+  RenderBackground(fx, display_mm);
+
+  const int kMaxHeightMM = 4000;
+  int sprite = 0;
+  for (int h = 0; h < kMaxHeightMM; h += 150) {
+    int y = (static_cast<int>(display_mm) - h) / 2;
+    int x = 24 + h / 16 % 64;
+    if (y < -RainbowFX::kHeight)
+      break;
+    if (sprite % 7 == 0) {
+      fx.template DrawSprite<typename FX::SpanDrawTraits1X>(
+          kSprites[sprite % 5], x * 2, y);
+    } else {
+      fx.template DrawSprite<typename FX::SpanDrawTraits>(kSprites[sprite % 4],
+                                                          x, y);
+    }
+    sprite++;
+  }
+
+  char buf[16];
+  itoa(display_mm / 10, buf, 10);
+
+  uint16_t w, h;
+  fx.MeasureText(buf, w, h);
+  // fx->Clear();
+  int x = RainbowFX::kWidth / 2 - w / 2;
+  int y = RainbowFX::kHeight / 2 - h / 2;
+  fx.DrawText(buf, x, y);
+}
+
+template void Render(RainbowFX& fx, uint32_t display_mm);
+template void Render(NativeFX& fx, uint32_t display_mm);
+template void Render(BeamFX& fx, uint32_t display_mm);
+template void RenderBackground(RainbowFX& fx, uint32_t display_mm);
+template void RenderBackground(NativeFX& fx, uint32_t display_mm);
+template void RenderBackground(BeamFX& fx, uint32_t display_mm);
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+
+// Draws the distance display scene for |display_mm| with |fx|, a RainbowFX,
+// NativeFX or BeamFX.
+template <typename FX>
+void Render(FX& fx, uint32_t display_mm);
+
+// Clears the backbuffer and draws only the scrolling background.
+template <typename FX>
+void RenderBackground(FX& fx, uint32_t display_mm);
@@ -0,0 +1,79 @@
+#include "sensor_task.h"
+
+#include <algorithm>
+
+// Only the task writes the counters, so they need no read-modify-write,
+// which the LX106 doesn't have.
+static void Increment(std::atomic<uint32_t>& counter) {
+  counter.store(counter.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+}
+
+SensorTask::SensorTask(std::unique_ptr<DistanceSensor> sensor,
+                       uint32_t period_ms)
+    : sensor_(std::move(sensor)), period_ms_(period_ms) {}
+
+bool SensorTask::Start(TaskHandle_t consumer,
+                       UBaseType_t priority,
+                       uint32_t stack_depth) {
+  consumer_ = consumer;
+  stopping_.store(false, std::memory_order_relaxed);
+  running_.store(true, std::memory_order_relaxed);
+  sensor_->Start(period_ms_);
+  if (xTaskCreate(Entry, "sensor", stack_depth, this, priority, &task_) !=
+      pdPASS) {
+    sensor_->Stop();
+    running_.store(false, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+SensorTask::Stats SensorTask::stats() const {
+  Stats stats;
+  stats.measurements = measurements_.load(std::memory_order_relaxed);
+  stats.polls = polls_.load(std::memory_order_relaxed);
+  stats.dropped = dropped_.load(std::memory_order_relaxed);
+  if (running())
+    stats.stack_high_water_mark = uxTaskGetStackHighWaterMark(task_);
+  return stats;
+}
+
+// static
+void SensorTask::Entry(void* arg) {
+  static_cast<SensorTask*>(arg)->Run();
+  vTaskDelete(nullptr);
+}
+
+void SensorTask::Run() {
+  // The sensor measures on its own clock. Sleep until the tick before the
+  // next measurement is due, then poll its status every tick until it's
+  // ready; a status read is a short I2C transaction, reading the result a
+  // long one.
+  const TickType_t period_ticks =
+      std::max<TickType_t>(period_ms_ / portTICK_PERIOD_MS, 2);
+  TickType_t due = xTaskGetTickCount();
+  while (!stopping_.load(std::memory_order_relaxed)) {
+    TickType_t now = xTaskGetTickCount();
+    if (static_cast<int32_t>(due - now) > 0) {
+      vTaskDelay(due - now);
+      continue;
+    }
+    Increment(polls_);
+    Measurement measurement;
+    if (!sensor_->GetDistanceMM(measurement.distance_mm)) {
+      vTaskDelay(1);
+      continue;
+    }
+    measurement.tick = now;
+    if (queue_.Push(measurement)) {
+      Increment(measurements_);
+    } else {
+      Increment(dropped_);
+    }
+    xTaskNotifyGive(consumer_);
+    due = now + period_ticks - 1;
+  }
+  sensor_->Stop();
+  running_.store(false, std::memory_order_release);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <FreeRTOS.h>
+#include <freertos/task.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+#include "distance_sensor.h"
+#include "spsc_queue.h"
+
+// A distance measurement, and the tick it was read at.
+struct Measurement {
+  TickType_t tick = 0;
+  uint32_t distance_mm = 0;
+};
+
+// Owns the distance sensor and reads it from a task of its own, so that the
+// I2C transactions don't add to the render task's frame times. Measurements
+// are queued for the render task, which is then notified, waking it up from
+// FrameScheduler::Wait().
+class SensorTask {
+ public:
+  using Queue = SPSCQueue<Measurement, 8>;
+
+  struct Stats {
+    uint32_t measurements = 0;
+    // Reads of the sensor's status, including those that found a
+    // measurement.
+    uint32_t polls = 0;
+    // Measurements that didn't fit in the queue.
+    uint32_t dropped = 0;
+    // The least free stack the task has had, from
+    // uxTaskGetStackHighWaterMark().
+    uint32_t stack_high_water_mark = 0;
+  };
+
+  SensorTask(std::unique_ptr<DistanceSensor> sensor, uint32_t period_ms);
+
+  // Starts the sensor and the task, which notifies |consumer| whenever it
+  // queues a measurement. Returns false if the task couldn't be created.
+  bool Start(TaskHandle_t consumer,
+             UBaseType_t priority,
+             uint32_t stack_depth);
+  // Makes the task stop the sensor and exit. The firmware never does; this
+  // is for the host tests.
+  void Stop() { stopping_.store(true, std::memory_order_relaxed); }
+  bool running() const { return running_.load(std::memory_order_acquire); }
+
+  // For the consumer only.
+  Queue& queue() { return queue_; }
+  // Writes the sensor's calibration to flash if it changed, see
+  // DistanceSensor::SaveCalibration(). The task itself never writes flash,
+  // which keeps its stack small.
+  bool SaveCalibration() { return sensor_->SaveCalibration(); }
+
+  Stats stats() const;
+
+ private:
+  static void Entry(void* arg);
+  void Run();
+
+  std::unique_ptr<DistanceSensor> sensor_;
+  const uint32_t period_ms_;
+  TaskHandle_t consumer_ = nullptr;
+  TaskHandle_t task_ = nullptr;
+  Queue queue_;
+
+  std::atomic<bool> stopping_{false};
+  std::atomic<bool> running_{false};
+  // Only written by the task.
+  std::atomic<uint32_t> measurements_{0};
+  std::atomic<uint32_t> polls_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
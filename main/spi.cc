@@ -1,11 +1,22 @@
 #include "spi.h"
 
+#include <esp_attr.h>
 #include <string.h>
 
+static void (*g_transfer_done_handler)(void*) = nullptr;
+static void* g_transfer_done_arg = nullptr;
+
+static void IRAM_ATTR OnSPIEvent(int event, void* arg) {
+  if (event == SPI_TRANS_DONE_EVENT && g_transfer_done_handler)
+    g_transfer_done_handler(g_transfer_done_arg);
+}
+
 void SetupSPI() {
   spi_config_t config;
   memset(&config, 0, sizeof(config));
   config.mode = SPI_MASTER_MODE;
+  config.intr_enable.val = SPI_MASTER_DEFAULT_INTR_ENABLE;
+  config.event_cb = OnSPIEvent;
   // SSD1331's min clock cycle is 150ns, which would mean ~6.7 MHz, but this
   // panel seems stable up to 40 MHz.
   config.clk_div = SPI_40MHz_DIV;
@@ -22,3 +33,8 @@ void SetupSPI() {
   interface.cs_en = true;
   spi_set_interface(HSPI_HOST, &interface);
 }
+
+void SetSPITransferDoneHandler(void (*handler)(void*), void* arg) {
+  g_transfer_done_arg = arg;
+  g_transfer_done_handler = handler;
+}
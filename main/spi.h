@@ -4,3 +4,7 @@
 #include <driver/spi.h>
 
 void SetupSPI();
+
+// Sets a function to call from the SPI interrupt whenever a transfer has
+// finished.
+void SetSPITransferDoneHandler(void (*handler)(void*), void* arg);
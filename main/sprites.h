@@ -6,682 +6,601 @@
 struct Sprite {
  uint8_t width;
  uint8_t height;
+ // Byte offsets into kSpriteData and kSpriteSpanData.
  uint16_t offset;
+ uint16_t span_offset;
+ uint16_t span_size;
+ // Byte offsets into kNativeSpriteData of the sprite pre-filtered to half
+ // size, as drawn at an even and at an odd row.
+ uint16_t native_offset[2];
+ uint8_t index;
 };
 
-constexpr uint8_t DRAM_ATTR kSpriteData[] = {
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x11,  0x11,  0x11,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x20,  0x21,
-  0x21,  0x11,  0x01,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x12,  0x13,  0x12,
-  0x11,  0x11,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x31,  0x21,  0x11,  0x11,
-  0x11,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x12,  0x13,  0x11,  0x11,  0x11,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x10,
-  0x11,  0x12,  0x22,  0x22,  0x22,  0x22,  0x00,  0x00,
-  0x00,  0x00,  0x21,  0x21,  0x11,  0x11,  0x11,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x10,  0x12,  0x00,  0x00,  0x00,  0x21,  0x21,
-  0x21,  0x22,  0x21,  0x22,  0x22,  0x12,  0x01,  0x00,
-  0x00,  0x12,  0x12,  0x11,  0x11,  0x11,  0x00,  0x10,
-  0x12,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x20,  0x11,  0x00,  0x00,  0x10,  0x12,  0x22,  0x22,
-  0x12,  0x22,  0x22,  0x32,  0x21,  0x11,  0x11,  0x00,
-  0x11,  0x11,  0x11,  0x11,  0x11,  0x00,  0x20,  0x11,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x10,
-  0x11,  0x00,  0x00,  0x21,  0x22,  0x22,  0x22,  0x22,
-  0x21,  0x22,  0x13,  0x12,  0x11,  0x11,  0x01,  0x10,
-  0x11,  0x11,  0x11,  0x01,  0x00,  0x10,  0x11,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x10,  0x22,  0x22,  0x12,  0x22,  0x12,  0x22,
-  0x22,  0x22,  0x11,  0x11,  0x11,  0x01,  0x00,  0x11,
-  0x11,  0x11,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x21,  0x21,  0x22,  0x21,  0x23,  0x22,  0x22,  0x22,
-  0x11,  0x11,  0x11,  0x11,  0x01,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x11,
-  0x22,  0x12,  0x32,  0x22,  0x22,  0x22,  0x22,  0x12,
-  0x11,  0x11,  0x21,  0x21,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x12,  0x11,  0x00,  0x00,  0x00,  0x00,  0x21,  0x22,
-  0x22,  0x21,  0x22,  0x12,  0x12,  0x12,  0x22,  0x11,
-  0x11,  0x12,  0x12,  0x01,  0x00,  0x00,  0x00,  0x12,
-  0x12,  0x00,  0x00,  0x00,  0x00,  0x00,  0x20,  0x21,
-  0x11,  0x01,  0x00,  0x00,  0x10,  0x22,  0x22,  0x12,
-  0x32,  0x22,  0x21,  0x21,  0x21,  0x21,  0x11,  0x21,
-  0x21,  0x11,  0x01,  0x00,  0x00,  0x20,  0x21,  0x11,
-  0x01,  0x00,  0x00,  0x00,  0x00,  0x10,  0x12,  0x11,
-  0x01,  0x00,  0x00,  0x20,  0x21,  0x22,  0x21,  0x23,
-  0x12,  0x12,  0x11,  0x11,  0x12,  0x11,  0x12,  0x12,
-  0x11,  0x01,  0x00,  0x00,  0x10,  0x12,  0x12,  0x01,
-  0x00,  0x00,  0x00,  0x00,  0x20,  0x21,  0x11,  0x01,
-  0x00,  0x00,  0x10,  0x22,  0x12,  0x32,  0x22,  0x22,
-  0x11,  0x11,  0x21,  0x21,  0x11,  0x11,  0x11,  0x11,
-  0x01,  0x00,  0x00,  0x20,  0x11,  0x11,  0x01,  0x00,
-  0x00,  0x00,  0x00,  0x10,  0x12,  0x11,  0x01,  0x00,
-  0x00,  0x20,  0x21,  0x22,  0x21,  0x22,  0x12,  0x12,
-  0x11,  0x12,  0x13,  0x11,  0x11,  0x11,  0x11,  0x00,
-  0x00,  0x00,  0x10,  0x11,  0x11,  0x01,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x11,  0x11,  0x00,  0x00,  0x00,
-  0x10,  0x22,  0x12,  0x22,  0x22,  0x22,  0x11,  0x21,
-  0x31,  0x11,  0x11,  0x11,  0x11,  0x11,  0x00,  0x00,
-  0x00,  0x00,  0x11,  0x11,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x10,
-  0x21,  0x22,  0x23,  0x22,  0x12,  0x12,  0x11,  0x13,
-  0x11,  0x12,  0x12,  0x11,  0x11,  0x01,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x10,  0x22,
-  0x22,  0x21,  0x22,  0x22,  0x21,  0x11,  0x11,  0x11,
-  0x21,  0x21,  0x21,  0x11,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x12,  0x01,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x10,  0x22,  0x12,
-  0x12,  0x22,  0x22,  0x22,  0x21,  0x11,  0x11,  0x11,
-  0x12,  0x12,  0x02,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x21,  0x01,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x22,  0x22,  0x21,
-  0x21,  0x21,  0x12,  0x12,  0x12,  0x11,  0x11,  0x11,
-  0x11,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x11,  0x01,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x10,  0x12,  0x22,  0x12,
-  0x12,  0x22,  0x21,  0x11,  0x11,  0x11,  0x11,  0x01,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x21,  0x21,  0x21,  0x22,
-  0x12,  0x12,  0x12,  0x11,  0x11,  0x11,  0x01,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x10,  0x22,  0x12,  0x12,  0x22,
-  0x11,  0x11,  0x11,  0x11,  0x11,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x11,  0x11,  0x11,  0x11,  0x11,
-  0x11,  0x11,  0x01,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0xed,  0xee,  0xee,  0xee,  0x0d,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0xed,  0xee,  0xee,  0xee,  0xee,  0xee,  0x0d,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xed,
-  0xee,  0xee,  0xde,  0xde,  0xee,  0xee,  0xee,  0x0d,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0xd0,  0xee,  0xee,
-  0xee,  0xee,  0xee,  0xee,  0xee,  0xee,  0xde,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0xed,  0xee,  0xee,  0xde,
-  0xee,  0xee,  0xde,  0xee,  0xee,  0xee,  0x0e,  0x00,
-  0x00,  0x00,  0xd0,  0xee,  0xee,  0xee,  0xee,  0xee,
-  0xee,  0xee,  0xee,  0xee,  0xee,  0xde,  0x00,  0x00,
-  0x00,  0xd0,  0xee,  0xee,  0xee,  0xee,  0xed,  0xee,
-  0xed,  0xee,  0xee,  0xed,  0xee,  0x00,  0x00,  0x00,
-  0xdc,  0xed,  0xed,  0xee,  0xee,  0xee,  0xed,  0xee,
-  0xee,  0xee,  0xee,  0xee,  0x0d,  0x00,  0x00,  0xdd,
-  0xdd,  0xde,  0xee,  0xee,  0xee,  0xee,  0xee,  0xee,
-  0xee,  0xee,  0xee,  0x0e,  0x00,  0xc0,  0xdd,  0xdd,
-  0xed,  0xed,  0xee,  0xee,  0xee,  0xee,  0xee,  0xee,
-  0xed,  0xee,  0xde,  0x00,  0xd0,  0xdd,  0xdd,  0xde,
-  0xee,  0xee,  0xee,  0xee,  0xee,  0xee,  0xed,  0xee,
-  0xed,  0xee,  0x00,  0xd0,  0xcd,  0xdd,  0xed,  0xed,
-  0xee,  0xee,  0xee,  0xee,  0xee,  0xee,  0xee,  0xee,
-  0xee,  0x00,  0xd0,  0xdd,  0xdd,  0xdd,  0xdd,  0xee,
-  0xed,  0xee,  0xed,  0xee,  0xed,  0xee,  0xed,  0xee,
-  0x00,  0xd0,  0xdd,  0xdd,  0xdd,  0xdd,  0xed,  0xee,
-  0xee,  0xee,  0xee,  0xee,  0xed,  0xee,  0xee,  0x00,
-  0xd0,  0xdd,  0xdd,  0xdd,  0xdd,  0xdd,  0xde,  0xee,
-  0xee,  0xee,  0xee,  0xee,  0xee,  0xee,  0x00,  0xd0,
-  0xdd,  0xdd,  0xdd,  0xdc,  0xdd,  0xed,  0xed,  0xee,
-  0xee,  0xee,  0xee,  0xee,  0xee,  0x00,  0xd0,  0xdd,
-  0xdd,  0xdc,  0xdd,  0xdc,  0xdd,  0xde,  0xde,  0xee,
-  0xed,  0xee,  0xed,  0xee,  0x00,  0xc0,  0xdd,  0xdd,
-  0xdd,  0xdd,  0xdd,  0xdd,  0xdd,  0xed,  0xed,  0xee,
-  0xee,  0xee,  0xde,  0x00,  0x00,  0xdd,  0xdd,  0xdc,
-  0xdd,  0xdc,  0xdd,  0xdd,  0xdd,  0xde,  0xee,  0xee,
-  0xee,  0x0e,  0x00,  0x00,  0xdc,  0xdd,  0xdd,  0xdc,
-  0xdd,  0xdd,  0xdd,  0xdd,  0xed,  0xed,  0xed,  0xed,
-  0x0d,  0x00,  0x00,  0xd0,  0xdd,  0xdd,  0xdd,  0xdd,
-  0xdd,  0xdd,  0xdd,  0xdd,  0xdd,  0xde,  0xee,  0x00,
-  0x00,  0x00,  0xc0,  0xdd,  0xdd,  0xdd,  0xcd,  0xdd,
-  0xdd,  0xcd,  0xdd,  0xdd,  0xed,  0xcd,  0x00,  0x00,
-  0x00,  0x00,  0xdc,  0xdd,  0xdd,  0xdc,  0xdc,  0xdd,
-  0xdc,  0xdd,  0xdd,  0xdd,  0x0c,  0x00,  0x00,  0x00,
-  0x00,  0xc0,  0xdd,  0xdd,  0xcd,  0xdd,  0xdd,  0xdd,
-  0xdd,  0xdd,  0xcd,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0xdc,  0xdd,  0xdd,  0xdd,  0xdd,  0xdd,  0xdd,
-  0xdd,  0x0c,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0xdc,  0xdd,  0xdd,  0xdd,  0xdd,  0xdd,  0x0c,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0xdc,  0xdd,  0xdd,  0xdd,  0x0c,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xc0,  0xcc,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x4c,  0x44,  0x0c,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0xcc,  0x00,  0xc0,
-  0xcc,  0xc0,  0xc4,  0xcc,  0x3c,  0x03,  0x00,  0x02,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0xc0,  0xcc,  0x55,  0xcc,  0x5c,  0x44,  0x0c,
-  0x0c,  0x00,  0xcc,  0xcc,  0x00,  0x00,  0x00,  0x10,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xac,
-  0x0c,  0xcc,  0x5c,  0xcc,  0xcc,  0x00,  0xc0,  0x04,
-  0x33,  0x33,  0x33,  0x23,  0xc3,  0x00,  0x00,  0x00,
-  0x01,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0xc0,  0xcb,  0x00,  0x56,
-  0xc0,  0x00,  0x0c,  0xcc,  0x44,  0x33,  0x33,  0x33,
-  0x23,  0x22,  0x32,  0x33,  0x02,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0xbc,  0xcb,  0x50,  0x05,  0xc0,  0xcc,
-  0xc4,  0x43,  0x34,  0x44,  0x33,  0x23,  0x32,  0x33,
-  0x23,  0x22,  0x22,  0x22,  0x0c,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xcc,
-  0xcc,  0xcc,  0x55,  0xcc,  0x4c,  0x44,  0x44,  0x34,
-  0x43,  0x44,  0x44,  0x44,  0x34,  0x33,  0x23,  0x12,
-  0x12,  0x12,  0x11,  0x01,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0xc0,  0xcb,  0xcb,  0x56,
-  0xc5,  0x4c,  0x54,  0x65,  0x46,  0x44,  0x44,  0x44,
-  0x33,  0x23,  0x22,  0x33,  0x33,  0x23,  0x22,  0x21,
-  0x11,  0xc1,  0x00,  0x08,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0xbc,  0xcb,  0xcc,  0x55,  0x65,  0x56,
-  0x55,  0x46,  0x45,  0x44,  0x44,  0x44,  0x44,  0x44,
-  0xc4,  0x00,  0x1c,  0x22,  0x12,  0x12,  0x11,  0x11,
-  0x08,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xc0,
-  0xba,  0xca,  0xac,  0xb5,  0xbb,  0x55,  0x65,  0x55,
-  0x56,  0xc6,  0xcc,  0xc4,  0x00,  0x00,  0x00,  0x20,
-  0x00,  0xc0,  0x22,  0x21,  0x11,  0x81,  0x81,  0x08,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0xc0,  0xaa,  0xcc,
-  0xbb,  0xbb,  0xbb,  0xbb,  0x55,  0x65,  0x65,  0x55,
-  0x0c,  0x00,  0x00,  0x30,  0x03,  0x00,  0x20,  0x00,
-  0xcc,  0x8c,  0x88,  0x88,  0x88,  0x80,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0xc0,  0xcc,  0xba,  0xbb,  0xbb,
-  0xbb,  0xbb,  0x5b,  0x55,  0x56,  0x0c,  0x00,  0x4c,
-  0x44,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x8c,  0x08,  0x08,  0x08,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0xac,  0xbb,  0xbb,  0xbb,  0xbb,  0xbb,
-  0x5b,  0x65,  0x0c,  0xcc,  0xcc,  0xc6,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x10,  0x00,  0x08,  0x00,
-  0x00,  0x00,  0x00,  0x08,  0x00,  0x00,  0x00,  0x00,
-  0xbc,  0xbb,  0xbb,  0xbb,  0xbb,  0xab,  0xbb,  0xc5,
-  0x00,  0x56,  0x5c,  0x0c,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x80,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xbc,  0xbb,
-  0xbb,  0xbb,  0xbb,  0xbb,  0xbb,  0x55,  0x65,  0xc6,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x08,  0x80,  0x00,  0x00,  0xac,  0xbb,  0xbb,  0xab,
-  0xab,  0xab,  0xbb,  0x55,  0xc5,  0xcc,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0xcc,  0xba,  0xbb,  0xbb,  0xba,  0xaa,
-  0xbb,  0x55,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0xcc,  0xbc,  0xab,  0xab,  0xaa,  0xba,  0xab,  0xcc,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x08,  0x00,  0x00,  0xc0,  0xcc,
-  0xbb,  0xbb,  0xbb,  0xbb,  0xcb,  0x0c,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0xcc,  0xac,  0xbb,
-  0xbb,  0xab,  0xcc,  0x0c,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0xc0,  0xcc,  0xcc,  0xcc,  0xcc,
-  0xcc,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0xc0,  0xcc,  0xcc,  0xcc,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x70,  0x77,  0x76,  0x76,  0x76,
-  0x06,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x77,  0x77,  0x66,
-  0x66,  0x66,  0x65,  0x67,  0x67,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x87,
-  0x77,  0x77,  0x77,  0x77,  0x76,  0x76,  0x55,  0x55,
-  0x76,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x80,  0x78,  0x77,  0x77,  0x77,  0x67,  0x67,
-  0x65,  0x67,  0x57,  0x65,  0x07,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x80,  0x78,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x76,  0x76,  0x76,  0x55,  0x75,
-  0x06,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x88,  0x88,
-  0x87,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x67,
-  0x67,  0x67,  0x55,  0x65,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x80,  0x78,  0x78,  0x78,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x76,  0x56,  0x76,  0x55,  0x06,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x80,  0x88,  0x87,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x67,
-  0x67,  0x57,  0x07,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x88,  0x88,
-  0x78,  0x78,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x56,  0x56,  0x55,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x80,  0x88,  0x88,  0x87,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x67,  0x57,
-  0x55,  0x05,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x80,  0x88,  0x78,  0x78,  0x78,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x76,  0x76,  0x56,  0x06,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x88,  0x88,
-  0x88,  0x87,  0x87,  0x77,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x67,  0x67,  0x65,  0x65,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x08,  0x08,
-  0x08,  0x88,  0x88,  0x78,  0x78,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x76,
-  0x56,  0x76,  0x56,  0x00,  0x08,  0x08,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x80,
-  0x80,  0x80,  0x80,  0x00,  0x88,  0x88,  0x87,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x67,  0x67,  0x67,  0x65,  0x05,  0x80,
-  0x80,  0x80,  0x80,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x08,  0x08,  0x08,  0x08,  0x08,  0x80,  0x88,
-  0x78,  0x88,  0x78,  0x78,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x76,  0x76,  0x56,
-  0x76,  0x06,  0x08,  0x08,  0x08,  0x08,  0x08,  0x08,
-  0x00,  0x00,  0x00,  0x80,  0x80,  0x80,  0x80,  0x80,
-  0x80,  0x80,  0x88,  0x88,  0x87,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,
-  0x67,  0x67,  0x67,  0x65,  0x05,  0x80,  0x80,  0x80,
-  0x80,  0x80,  0x80,  0x00,  0x00,  0x00,  0x08,  0x08,
-  0x08,  0x08,  0x08,  0x08,  0x80,  0x88,  0x78,  0x78,
-  0x78,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x76,  0x77,  0x76,  0x06,
-  0x08,  0x08,  0x08,  0x08,  0x08,  0x08,  0x08,  0x08,
-  0x80,  0x80,  0x80,  0x80,  0x80,  0x80,  0x00,  0x80,
-  0x88,  0x88,  0x87,  0x78,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x67,
-  0x77,  0x67,  0x55,  0x00,  0x80,  0x80,  0x80,  0x80,
-  0x80,  0x80,  0x80,  0x08,  0x08,  0x08,  0x08,  0x08,
-  0x00,  0x00,  0x80,  0x88,  0x78,  0x78,  0x78,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x76,  0x76,  0x76,  0x56,  0x00,  0x00,
-  0x00,  0x08,  0x08,  0x08,  0x08,  0x08,  0x80,  0x80,
-  0x80,  0x80,  0x80,  0x80,  0x00,  0x80,  0x88,  0x88,
-  0x87,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x67,  0x77,  0x67,
-  0x55,  0x00,  0x80,  0x80,  0x80,  0x80,  0x80,  0x80,
-  0x80,  0x08,  0x08,  0x08,  0x08,  0x08,  0x08,  0x08,
-  0x88,  0x88,  0x88,  0x78,  0x78,  0x77,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,
-  0x77,  0x76,  0x76,  0x58,  0x08,  0x08,  0x08,  0x08,
-  0x08,  0x08,  0x08,  0x08,  0x80,  0x80,  0x80,  0x80,
-  0x80,  0x80,  0x80,  0x80,  0x88,  0x88,  0x88,  0x87,
-  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,
-  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,  0x85,  0x80,
-  0x80,  0x80,  0x80,  0x80,  0x80,  0x80,  0x00,  0x00,
-  0x08,  0x08,  0x08,  0x08,  0x08,  0x08,  0x88,  0x88,
-  0x78,  0x88,  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,
-  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,
-  0x78,  0x08,  0x08,  0x08,  0x08,  0x08,  0x08,  0x08,
-  0x08,  0x00,  0x00,  0x80,  0x80,  0x80,  0x80,  0x80,
-  0x80,  0x80,  0x88,  0x88,  0x87,  0x87,  0x87,  0x87,
-  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,
-  0x87,  0x87,  0x87,  0x87,  0x85,  0x80,  0x80,  0x80,
-  0x80,  0x80,  0x80,  0x00,  0x00,  0x00,  0x00,  0x08,
-  0x08,  0x08,  0x08,  0x08,  0x08,  0x88,  0x78,  0x78,
-  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,
-  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,  0x58,  0x08,
-  0x08,  0x08,  0x08,  0x08,  0x08,  0x08,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x80,  0x80,  0x80,  0x80,  0x80,
-  0x88,  0x87,  0x87,  0x88,  0x87,  0x87,  0x87,  0x87,
-  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,
-  0x87,  0x87,  0x80,  0x80,  0x80,  0x80,  0x80,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x08,  0x08,
-  0x08,  0x08,  0x08,  0x88,  0x88,  0x78,  0x78,  0x78,
-  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,
-  0x78,  0x78,  0x78,  0x78,  0x58,  0x08,  0x08,  0x08,
-  0x08,  0x08,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x80,  0x80,  0x80,  0x80,  0x80,  0x88,
-  0x88,  0x88,  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,
-  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,  0x85,
-  0x80,  0x80,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x08,
-  0x08,  0x88,  0x88,  0x78,  0x78,  0x78,  0x78,  0x78,
-  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,  0x78,
-  0x78,  0x78,  0x08,  0x08,  0x08,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x88,  0x88,  0x88,
-  0x88,  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,  0x87,
-  0x87,  0x87,  0x77,  0x67,  0x67,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x80,  0x88,  0x88,  0x78,  0x78,  0x77,  0x78,  0x77,
-  0x77,  0x77,  0x77,  0x77,  0x77,  0x77,  0x76,  0x06,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x80,  0x88,  0x88,  0x88,  0x87,
-  0x87,  0x87,  0x77,  0x87,  0x77,  0x77,  0x77,  0x77,
-  0x67,  0x67,  0x07,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x88,
-  0x88,  0x78,  0x88,  0x78,  0x78,  0x78,  0x77,  0x77,
-  0x77,  0x77,  0x77,  0x76,  0x76,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x80,  0x88,  0x88,  0x88,  0x87,  0x87,
-  0x87,  0x87,  0x77,  0x77,  0x77,  0x67,  0x67,  0x07,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x80,  0x88,
-  0x88,  0x78,  0x88,  0x88,  0x88,  0x88,  0x77,  0x77,
-  0x77,  0x07,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x88,  0x88,  0x88,  0x88,  0x88,  0x88,
-  0x88,  0x78,  0x77,  0x77,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x88,  0x88,
-  0x88,  0x88,  0x88,  0x88,  0x88,  0x88,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x88,  0x88,  0x88,  0x88,  0x88,  0x88,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x88,
-  0x88,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0xc0,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xe0,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x0c,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0xec,  0x0c,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xc0,  0xe0,
-  0xee,  0xee,  0xc0,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0xec,  0x0c,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0xe0,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xc0,
-  0x00,  0x00,  0x00,  0x00,  0xc0,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x0c,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xc0,  0xcc,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x0c,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0xc0,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0xe0,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xec,
-  0x0c,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0xc0,  0xe0,  0xee,  0xee,  0xc0,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0xec,  0x0c,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xe0,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0xc0,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0xc0,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0xcc,  0x0c,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0xc0,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x0c,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x0c,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0xc0,  0xcc,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x0c,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x0c,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x0c,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x0c,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x0e,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0xc0,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0xc0,
-  0xce,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x0c,  0xee,  0xee,  0x0e,  0x0c,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0xc0,  0xce,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x0e,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x0c,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
-  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,
+constexpr uint32_t kSpriteData[] = {
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00111111, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x21200000, 0x00011121, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x12131200, 0x00001111, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x11112131,
+  0x00000011, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x12000000, 0x11111113, 0x00000000, 0x00000000, 0x00000000, 0x10000000,
+  0x22221211, 0x00002222, 0x21210000, 0x00111111, 0x00000000, 0x00000000,
+  0x00121000, 0x21210000, 0x22212221, 0x00011222, 0x11121200, 0x10001111,
+  0x00000012, 0x00000000, 0x00001120, 0x22221210, 0x32222212, 0x00111121,
+  0x11111111, 0x11200011, 0x00000000, 0x10000000, 0x21000011, 0x22222222,
+  0x12132221, 0x10011111, 0x01111111, 0x00111000, 0x00000000, 0x00000000,
+  0x22221000, 0x22122212, 0x11112222, 0x11000111, 0x00001111, 0x00000000,
+  0x00000000, 0x00000000, 0x21222121, 0x22222223, 0x11111111, 0x00000001,
+  0x00000000, 0x00000000, 0x00000000, 0x11000000, 0x22321222, 0x12222222,
+  0x21211111, 0x00000000, 0x00000000, 0x00000000, 0x00001112, 0x22210000,
+  0x12222122, 0x11221212, 0x01121211, 0x12000000, 0x00000012, 0x21200000,
+  0x00000111, 0x12222210, 0x21212232, 0x21112121, 0x00011121, 0x11212000,
+  0x00000001, 0x11121000, 0x20000001, 0x23212221, 0x11111212, 0x12121112,
+  0x00000111, 0x01121210, 0x00000000, 0x01112120, 0x22100000, 0x22223212,
+  0x21211111, 0x11111111, 0x20000001, 0x00011111, 0x10000000, 0x00011112,
+  0x22212000, 0x12122221, 0x11131211, 0x00111111, 0x11100000, 0x00000111,
+  0x11000000, 0x00000011, 0x22122210, 0x21112222, 0x11111131, 0x00001111,
+  0x11110000, 0x00000000, 0x00000000, 0x10000000, 0x22232221, 0x13111212,
+  0x11121211, 0x00000111, 0x00000000, 0x00000000, 0x00000000, 0x22100000,
+  0x22222122, 0x11111121, 0x11212121, 0x00000000, 0x00000000, 0x00000112,
+  0x00000000, 0x12221000, 0x22222212, 0x11111121, 0x00021212, 0x00000000,
+  0x21000000, 0x00000001, 0x00000000, 0x21222200, 0x12122121, 0x11111112,
+  0x00000011, 0x00000000, 0x01110000, 0x00000000, 0x00000000, 0x12221210,
+  0x11212212, 0x01111111, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x22212121, 0x11121212, 0x00011111, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x10000000, 0x22121222, 0x11111111, 0x00000011,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x11000000, 0x11111111,
+  0x00011111, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xeeeeed00,
+  0x00000dee, 0x00000000, 0xed000000, 0xeeeeeeee, 0x00000dee, 0x00000000,
+  0xeeeeed00, 0xeeeedede, 0x00000dee, 0xd0000000, 0xeeeeeeee, 0xeeeeeeee,
+  0x000000de, 0xeeed0000, 0xeeeedeee, 0xeeeeeede, 0x0000000e, 0xeeeeeed0,
+  0xeeeeeeee, 0xdeeeeeee, 0xd0000000, 0xeeeeeeee, 0xeeedeeed, 0x00eeedee,
+  0xeddc0000, 0xeeeeeeed, 0xeeeeeeed, 0x000deeee, 0xdedddd00, 0xeeeeeeee,
+  0xeeeeeeee, 0xc0000eee, 0xededdddd, 0xeeeeeeee, 0xeeedeeee, 0xddd000de,
+  0xeeeededd, 0xeeeeeeee, 0xeeedeeed, 0xddcdd000, 0xeeeeeded, 0xeeeeeeee,
+  0x00eeeeee, 0xddddddd0, 0xeeedeedd, 0xeeedeeed, 0xd000eeed, 0xdddddddd,
+  0xeeeeeeed, 0xeeedeeee, 0xddd000ee, 0xdddddddd, 0xeeeeeede, 0xeeeeeeee,
+  0xddddd000, 0xeddddcdd, 0xeeeeeeed, 0x00eeeeee, 0xdcddddd0, 0xdedddcdd,
+  0xeeedeede, 0xc000eeed, 0xdddddddd, 0xeddddddd, 0xeeeeeeed, 0xdd0000de,
+  0xdcdddcdd, 0xdedddddd, 0x0eeeeeee, 0xdddc0000, 0xdddddcdd, 0xededdddd,
+  0x000deded, 0xddddd000, 0xdddddddd, 0xdedddddd, 0x000000ee, 0xddddddc0,
+  0xcdddddcd, 0xcdeddddd, 0x00000000, 0xdcdddddc, 0xdddcdddc, 0x000cdddd,
+  0xc0000000, 0xddcddddd, 0xdddddddd, 0x000000cd, 0xdc000000, 0xdddddddd,
+  0x0cdddddd, 0x00000000, 0xdc000000, 0xdddddddd, 0x00000cdd, 0x00000000,
+  0xdc000000, 0x0cdddddd, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0xc0000000, 0x000000cc, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x0c444c00, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00cc0000, 0xc4c0ccc0, 0x00033ccc, 0x00000002,
+  0x00000000, 0x00000000, 0x00000000, 0xccc00000, 0x445ccc55, 0xcc000c0c,
+  0x000000cc, 0x00000010, 0x00000000, 0x00000000, 0x00000000, 0x5ccc0cac,
+  0xc000cccc, 0x33333304, 0x0000c323, 0x00000100, 0x00000000, 0x00000000,
+  0x00cbc000, 0x0c00c056, 0x333344cc, 0x32222333, 0x00000233, 0x00000000,
+  0x00000000, 0xbc000000, 0xc00550cb, 0x3443c4cc, 0x32233344, 0x22222333,
+  0x00000c22, 0x00000000, 0x00000000, 0x55cccccc, 0x44444ccc, 0x44444334,
+  0x23333444, 0x11121212, 0x00000001, 0x00000000, 0xcbcbc000, 0x544cc556,
+  0x44444665, 0x22233344, 0x22233333, 0x00c11121, 0x00000008, 0xbc000000,
+  0x6555cccb, 0x45465556, 0x44444444, 0x1c00c444, 0x11121222, 0x00000811,
+  0x00000000, 0xaccabac0, 0x6555bbb5, 0xccc65655, 0x000000c4, 0x22c00020,
+  0x81811121, 0x00000008, 0xaac00000, 0xbbbbbbcc, 0x656555bb, 0x00000c55,
+  0x20000330, 0x888ccc00, 0x00808888, 0x00000000, 0xbbbaccc0, 0x5bbbbbbb,
+  0x000c5655, 0x0000444c, 0x00000000, 0x088c0000, 0x00000808, 0xac000000,
+  0xbbbbbbbb, 0x0c655bbb, 0x00c6cccc, 0x00000000, 0x08001000, 0x00000000,
+  0x00000008, 0xbbbbbc00, 0xbbabbbbb, 0x5c5600c5, 0x0000000c, 0x00000000,
+  0x80000000, 0x00000000, 0xbc000000, 0xbbbbbbbb, 0x6555bbbb, 0x000000c6,
+  0x00000000, 0x00000000, 0x00000000, 0x00800800, 0xbbbbac00, 0xbbababab,
+  0x00ccc555, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xcc000000,
+  0xbabbbbba, 0x0055bbaa, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0xabbccc00, 0xabbaaaab, 0x000000cc, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0xc0000008, 0xbbbbbbcc, 0x000ccbbb, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xaccc0000, 0xccabbbbb,
+  0x0000000c, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0xccccccc0, 0x0000cccc, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0xc0000000, 0x00cccccc, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x77700000, 0x06767676, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x66667777, 0x67676566, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x77870000,
+  0x76777777, 0x76555576, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x77777880, 0x65676777, 0x07655767, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x78800000, 0x77777777,
+  0x76767777, 0x06755576, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x87888800, 0x77777777, 0x67677777, 0x00655567, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x80000000, 0x77787878, 0x77777777,
+  0x56767777, 0x00065576, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x88800000, 0x77777787, 0x77777777, 0x67677777, 0x00000757, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x78888800, 0x77777778, 0x77777777,
+  0x56567777, 0x00000055, 0x00000000, 0x00000000, 0x00000000, 0x80000000,
+  0x77878888, 0x77777777, 0x77777777, 0x55576777, 0x00000005, 0x00000000,
+  0x00000000, 0x00000000, 0x88800000, 0x77787878, 0x77777777, 0x77777777,
+  0x06567676, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x88888800,
+  0x77778787, 0x77777777, 0x67777777, 0x00656567, 0x00000000, 0x00000000,
+  0x00000000, 0x08080800, 0x78788888, 0x77777777, 0x77777777, 0x56767777,
+  0x08005676, 0x00000008, 0x00000000, 0x80800000, 0x88008080, 0x77778788,
+  0x77777777, 0x77777777, 0x67676777, 0x80800565, 0x00008080, 0x00000000,
+  0x08080808, 0x78888008, 0x77787888, 0x77777777, 0x77777777, 0x76567676,
+  0x08080806, 0x00080808, 0x80800000, 0x80808080, 0x87888880, 0x77777777,
+  0x77777777, 0x67777777, 0x05656767, 0x80808080, 0x00008080, 0x08080800,
+  0x80080808, 0x78787888, 0x77777777, 0x77777777, 0x76777777, 0x08067677,
+  0x08080808, 0x80080808, 0x80808080, 0x88800080, 0x77788788, 0x77777777,
+  0x77777777, 0x77677777, 0x80005567, 0x80808080, 0x08088080, 0x00080808,
+  0x78888000, 0x77777878, 0x77777777, 0x77777777, 0x76767677, 0x00000056,
+  0x08080808, 0x80808008, 0x00808080, 0x87888880, 0x77777777, 0x77777777,
+  0x77777777, 0x55677767, 0x80808000, 0x80808080, 0x08080808, 0x88080808,
+  0x78788888, 0x77777777, 0x77777777, 0x77777777, 0x08587676, 0x08080808,
+  0x80080808, 0x80808080, 0x88808080, 0x87878888, 0x87878787, 0x87878787,
+  0x87878787, 0x80808587, 0x80808080, 0x08000080, 0x08080808, 0x78888808,
+  0x78787888, 0x78787878, 0x78787878, 0x78787878, 0x08080808, 0x08080808,
+  0x80800000, 0x80808080, 0x87888880, 0x87878787, 0x87878787, 0x87878787,
+  0x85878787, 0x80808080, 0x00008080, 0x08080000, 0x08080808, 0x78787888,
+  0x78787878, 0x78787878, 0x78787878, 0x08085878, 0x08080808, 0x00000008,
+  0x80800000, 0x88808080, 0x87888787, 0x87878787, 0x87878787, 0x87878787,
+  0x80808087, 0x00008080, 0x00000000, 0x08080800, 0x88880808, 0x78787878,
+  0x78787878, 0x78787878, 0x58787878, 0x08080808, 0x00000008, 0x00000000,
+  0x80808000, 0x88888080, 0x87878788, 0x87878787, 0x87878787, 0x80858787,
+  0x00000080, 0x00000000, 0x00000000, 0x08080000, 0x78788888, 0x78787878,
+  0x78787878, 0x78787878, 0x08080878, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x88888888, 0x87878787, 0x87878787, 0x67677787, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x80000000, 0x78788888, 0x77777877,
+  0x77777777, 0x00067677, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x88800000, 0x87878888, 0x77877787, 0x67777777, 0x00000767, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x88880000, 0x78788878, 0x77777778,
+  0x76767777, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x88888000, 0x87878788, 0x77777787, 0x00076767, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x88888000, 0x88888878, 0x77777788,
+  0x00000007, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x88888800, 0x88888888, 0x00777778, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x88888800, 0x88888888, 0x00000088,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x88888800, 0x00888888, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x88880000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00c00000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x000000e0, 0x00000000, 0x00000000, 0x00000000, 0x000c0000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x000cec00,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xeeeee0c0, 0x000000c0,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0xec000000, 0x0000000c, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x000000e0, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x0000c000, 0x00c00000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x0000000c, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x0000ccc0, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x000c0000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00c00000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x000000e0,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x000cec00, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0xeeeee0c0, 0x000000c0, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0xec000000, 0x0000000c, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x000000e0, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x0000c000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00c00000, 0x00000000, 0x0ccc0000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0xc0000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x000c0000, 0x00000000, 0x00000000, 0x000c0000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0xccc00000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x0000000c, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x000c0000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x0c000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000c00, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000e00, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00c00000, 0x00000000,
+  0x00000000, 0x00000000, 0x00cec000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0xeeee0c00, 0x00000c0e, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0xc0000000, 0x000000ce, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000e00, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x0c000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+};
+constexpr uint32_t kSpriteSpanData[] = {
+  0x11110318, 0x17000011, 0x03002081, 0x00112121, 0x00000181, 0x13120517,
+  0x00111112, 0x31051700, 0x11111121, 0x05170000, 0x11111312, 0x0c000011,
+  0x06001081, 0x22221211, 0x05042222, 0x11112121, 0x07000011, 0x01001081,
+  0x21080312, 0x21222121, 0x00122222, 0x05020181, 0x11111212, 0x10810111,
+  0x00120100, 0x20810700, 0x02110100, 0x0a001081, 0x12222212, 0x21322222,
+  0x05011111, 0x11111111, 0x20810111, 0x00110100, 0x10810700, 0x02110100,
+  0x2222210b, 0x22212222, 0x11111213, 0x10018200, 0x11110300, 0x01810011,
+  0x00108101, 0x00001101, 0x0010810a, 0x1222220b, 0x22221222, 0x11111122,
+  0x01018100, 0x11111103, 0x0c0a0000, 0x21222121, 0x22222223, 0x11111111,
+  0x00018100, 0x110d0a00, 0x22321222, 0x12222222, 0x21211111, 0x02040000,
+  0x0d041112, 0x21222221, 0x12121222, 0x12111122, 0x01810012, 0x12120203,
+  0x81030000, 0x21020020, 0x01810011, 0x00108102, 0x1222220d, 0x21212232,
+  0x21112121, 0x81001121, 0x20810201, 0x11210200, 0x00018100, 0x10810300,
+  0x11120200, 0x02018100, 0x0d002081, 0x23212221, 0x11111212, 0x12121112,
+  0x01810011, 0x00108102, 0x00121202, 0x00000181, 0x00208103, 0x00112102,
+  0x81020181, 0x220d0010, 0x22223212, 0x21211111, 0x11111111, 0x02018100,
+  0x02002081, 0x81001111, 0x03000001, 0x02001081, 0x81001112, 0x20810201,
+  0x22210d00, 0x12122221, 0x11131211, 0x03111111, 0x02001081, 0x81001111,
+  0x04000001, 0x03111102, 0x0d001081, 0x22221222, 0x31211122, 0x11111111,
+  0x11020411, 0x09000011, 0x0d001081, 0x22232221, 0x13111212, 0x11121211,
+  0x01810011, 0x81090000, 0x220d0010, 0x22222122, 0x11111121, 0x11212121,
+  0x01000000, 0x01810012, 0x00108107, 0x1212220c, 0x21222222, 0x12111111,
+  0x02810012, 0x01000000, 0x01810021, 0x22220c08, 0x12212121, 0x11111212,
+  0x00001111, 0x00110100, 0x81080181, 0x120a0010, 0x22121222, 0x11111121,
+  0x01810011, 0x0a0b0000, 0x22212121, 0x11121212, 0x81001111, 0x0b000001,
+  0x09001081, 0x22121222, 0x11111111, 0x0c000011, 0x11111107, 0x11111111,
+  0x00018100, 0x00000000, 0xeeed0405, 0x8100eeee, 0x0400000d, 0xeeeeed06,
+  0x00eeeeee, 0x00000d81, 0xeeed0803, 0xeededeee, 0x8100eeee, 0x0200000d,
+  0x0900d081, 0xeeeeeeee, 0xeeeeeeee, 0x020000de, 0xeeeeed0a, 0xdeeeeede,
+  0x00eeeeee, 0x00000e81, 0x00d08101, 0xeeeeee0b, 0xeeeeeeee, 0xdeeeeeee,
+  0x81010000, 0xee0b00d0, 0xedeeeeee, 0xeeeeedee, 0x0000eeed, 0xeddc0c01,
+  0xeeeeeeed, 0xeeeeeeed, 0x8100eeee, 0x0100000d, 0xdedddd0c, 0xeeeeeeee,
+  0xeeeeeeee, 0x0e8100ee, 0x81000000, 0xdd0d00c0, 0xeeededdd, 0xeeeeeeee,
+  0xdeeeedee, 0x81000000, 0xdd0d00d0, 0xeeeededd, 0xeeeeeeee, 0xeeedeeed,
+  0x81000000, 0xcd0d00d0, 0xeeededdd, 0xeeeeeeee, 0xeeeeeeee, 0x81000000,
+  0xdd0d00d0, 0xeedddddd, 0xeeedeeed, 0xeeedeeed, 0x81000000, 0xdd0d00d0,
+  0xeddddddd, 0xeeeeeeee, 0xeeeeedee, 0x81000000, 0xdd0d00d0, 0xdddddddd,
+  0xeeeeeede, 0xeeeeeeee, 0x81000000, 0xdd0d00d0, 0xdddcdddd, 0xeeeeeded,
+  0xeeeeeeee, 0x81000000, 0xdd0d00d0, 0xdcdddcdd, 0xeedededd, 0xeeedeeed,
+  0x81000000, 0xdd0d00c0, 0xdddddddd, 0xededdddd, 0xdeeeeeee, 0x0c010000,
+  0xdddcdddd, 0xdddddddc, 0xeeeeeede, 0x000e8100, 0xdc0c0100, 0xdddcdddd,
+  0xeddddddd, 0x00ededed, 0x00000d81, 0x00d08101, 0xdddddd0b, 0xdddddddd,
+  0xeededddd, 0x81010000, 0xdd0b00c0, 0xddcddddd, 0xddddcddd, 0x0000cded,
+  0xdddc0a02, 0xdddcdcdd, 0xdddddddc, 0x000c8100, 0xc0810200, 0xdddd0900,
+  0xddddddcd, 0x00cddddd, 0xdc080300, 0xdddddddd, 0x00dddddd, 0x00000c81,
+  0xdddc0604, 0xdddddddd, 0x000c8100, 0xdc040500, 0x00dddddd, 0x00000c81,
+  0x00c0810b, 0x0000cc01, 0x444c020b, 0x000c8100, 0xcc010600, 0x00c08101,
+  0x8100cc01, 0xc40300c0, 0x81003ccc, 0x02810103, 0x81040000, 0xcc0500c0,
+  0x445ccc55, 0x0c0c8200, 0xcccc0201, 0x00108103, 0xac010400, 0x000c8100,
+  0xcc5ccc04, 0xc08201cc, 0x33050004, 0xc3233333, 0x00018103, 0xc0810300,
+  0x01cb0100, 0x81005601, 0x0c8101c0, 0x44cc0900, 0x23333333, 0x00333222,
+  0x00000281, 0xcbbc0203, 0x05508300, 0xcc0d00c0, 0x443443c4, 0x33322333,
+  0x22222223, 0x000c8100, 0xcc140200, 0xcc55cccc, 0x3444444c, 0x44444443,
+  0x12233334, 0x00111212, 0x00000181, 0x00c08101, 0x56cbcb15, 0x65544cc5,
+  0x44444446, 0x33222333, 0x21222333, 0x8101c111, 0x01000008, 0xcccbbc0f,
+  0x55566555, 0x44444546, 0xc4444444, 0x221c0601, 0x11111212, 0x00088100,
+  0xc0810000, 0xcaba0c00, 0x55bbb5ac, 0xc6565565, 0x8103c4cc, 0xc0810120,
+  0x21220500, 0x00818111, 0x00000881, 0x00c08100, 0xbbccaa0a, 0x55bbbbbb,
+  0x00556565, 0x82020c81, 0x81010330, 0xcc050120, 0x8888888c, 0x00808100,
+  0xc0810000, 0xbacc0900, 0xbbbbbbbb, 0x0056555b, 0x02010c81, 0x0108444c,
+  0x0883008c, 0x00000808, 0xbbac0801, 0xbbbbbbbb, 0x8100655b, 0xcc03000c,
+  0x8106c6cc, 0x08810110, 0x00088104, 0xbc080100, 0xbbbbbbbb, 0x01c5bbab,
+  0x005c5602, 0x810a0c81, 0x01000080, 0xbbbbbc0a, 0xbbbbbbbb, 0x10c66555,
+  0x00800882, 0xac0a0100, 0xababbbbb, 0xc555bbab, 0x010000cc, 0xbbbacc08,
+  0xbbaababb, 0x01000055, 0xabbccc08, 0xabbaaaab, 0x088113cc, 0x81010000,
+  0xcc0600c0, 0xbbbbbbbb, 0x0c8100cb, 0x06020000, 0xbbbbaccc, 0x8100ccab,
+  0x0200000c, 0x0500c081, 0xcccccccc, 0x030000cc, 0x0300c081, 0x00cccccc,
+  0x00000000, 0x0070810e, 0x76767704, 0x06810076, 0x080d0000, 0x66667777,
+  0x67676566, 0x0a0c0000, 0x77777787, 0x55767677, 0x00007655, 0x0080810b,
+  0x7777780a, 0x65676777, 0x00655767, 0x00000781, 0x0080810a, 0x7777780c,
+  0x77777777, 0x55767676, 0x06810075, 0x0e0a0000, 0x77878888, 0x77777777,
+  0x67676777, 0x00006555, 0x00808109, 0x7878780e, 0x77777777, 0x76777777,
+  0x00557656, 0x00000681, 0x00808109, 0x7787880e, 0x77777777, 0x77777777,
+  0x00576767, 0x00000781, 0x88881009, 0x77777878, 0x77777777, 0x56777777,
+  0x00005556, 0x00808108, 0x87888810, 0x77777777, 0x77777777, 0x57677777,
+  0x05810055, 0x81080000, 0x88100080, 0x77787878, 0x77777777, 0x77777777,
+  0x00567676, 0x00000681, 0x88881208, 0x77878788, 0x77777777, 0x77777777,
+  0x65656767, 0x83050000, 0x00080808, 0x78888812, 0x77777778, 0x77777777,
+  0x76777777, 0x01567656, 0x00080882, 0x80840300, 0x01808080, 0x87888812,
+  0x77777777, 0x77777777, 0x67777777, 0x00656767, 0x80800585, 0x00008080,
+  0x08088602, 0x80080808, 0x78881200, 0x77787888, 0x77777777, 0x77777777,
+  0x76567676, 0x08068700, 0x08080808, 0x01000008, 0x80808087, 0x80808080,
+  0x88881200, 0x77777787, 0x77777777, 0x77777777, 0x65676767, 0x80058700,
+  0x80808080, 0x01000080, 0x08080887, 0x80080808, 0x78881200, 0x77777878,
+  0x77777777, 0x77777777, 0x76777677, 0x08068900, 0x08080808, 0x00080808,
+  0x80860000, 0x80808080, 0x80810180, 0x88881300, 0x77777887, 0x77777777,
+  0x77777777, 0x67776777, 0x80870155, 0x80808080, 0x00008080, 0x08088500,
+  0x02080808, 0x13008081, 0x78787888, 0x77777777, 0x77777777, 0x76777777,
+  0x03567676, 0x08080885, 0x00000808, 0x80808600, 0x80808080, 0x00808101,
+  0x87888813, 0x77777777, 0x77777777, 0x77777777, 0x55677767, 0x80808701,
+  0x80808080, 0x00000080, 0x08080887, 0x08080808, 0x88881400, 0x77787888,
+  0x77777777, 0x77777777, 0x76777777, 0x88005876, 0x08080808, 0x08080808,
+  0x88000000, 0x80808080, 0x80808080, 0x88881300, 0x87878788, 0x87878787,
+  0x87878787, 0x87878787, 0x80870085, 0x80808080, 0x00008080, 0x08088601,
+  0x08080808, 0x88881300, 0x78788878, 0x78787878, 0x78787878, 0x78787878,
+  0x08880078, 0x08080808, 0x00080808, 0x80870100, 0x80808080, 0x13008080,
+  0x87878888, 0x87878787, 0x87878787, 0x87878787, 0x00858787, 0x80808086,
+  0x00808080, 0x08860200, 0x08080808, 0x88120008, 0x78787878, 0x78787878,
+  0x78787878, 0x78787878, 0x08870058, 0x08080808, 0x00000808, 0x80808503,
+  0x00808080, 0x87878812, 0x87878788, 0x87878787, 0x87878787, 0x00878787,
+  0x80808085, 0x00008080, 0x08088503, 0x00080808, 0x78888812, 0x78787878,
+  0x78787878, 0x78787878, 0x00587878, 0x08080885, 0x00000808, 0x80808504,
+  0x00808080, 0x88888811, 0x87878787, 0x87878787, 0x87878787, 0x82008587,
+  0x00008080, 0x08088206, 0x88881100, 0x78787878, 0x78787878, 0x78787878,
+  0x00787878, 0x08080883, 0x10090000, 0x88888888, 0x87878787, 0x87878787,
+  0x67677787, 0x81090000, 0x880e0080, 0x77787888, 0x77777778, 0x77777777,
+  0x06810076, 0x81090000, 0x880e0080, 0x87878888, 0x77877787, 0x67777777,
+  0x07810067, 0x0e0a0000, 0x88788888, 0x77787878, 0x77777777, 0x00007676,
+  0x0080810a, 0x8888880c, 0x87878787, 0x67777777, 0x07810067, 0x810b0000,
+  0x880a0080, 0x88887888, 0x77778888, 0x07810077, 0x0a0c0000, 0x88888888,
+  0x78888888, 0x00007777, 0x8888080d, 0x88888888, 0x00008888, 0x8888060e,
+  0x88888888, 0x02100000, 0x00008888, 0x00c0812a, 0x2a000000, 0x0000e081,
+  0x1a0c810f, 0x8100ec01, 0x2800000c, 0x00e0c082, 0x00eeee02, 0x0000c081,
+  0x00ec012a, 0x00000c81, 0x00e0812a, 0x25000000, 0x8104c081, 0x000000c0,
+  0x0c811600, 0x81150000, 0xcc0100c0, 0x81160000, 0x0500000c, 0x0000c081,
+  0x81050000, 0x050000e0, 0x8100ec01, 0x0300000c, 0x00e0c082, 0x00eeee02,
+  0x0000c081, 0x00ec0105, 0x00000c81, 0x00e08105, 0xc0810d00, 0x81050000,
+  0xcc0107c0, 0x000c8100, 0xc0810d00, 0x00000000, 0x00000000, 0x0b0c8114,
+  0x00000c81, 0x00c0811f, 0x0000cc01, 0x000c8120, 0x00000000, 0x00000c81,
+  0x00000000, 0x00000000, 0x00000000, 0x110c8116, 0x00000c81, 0x81160000,
+  0x0600000e, 0x810ec081, 0xce0100c0, 0x81140000, 0xee02000c, 0x0e8200ee,
+  0x1500000c, 0x0100c081, 0x160000ce, 0x00000e81, 0x81160000, 0x0000000c,
+};
+constexpr uint32_t kNativeSpriteData[] = {
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x02000000,
+  0x01111111, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x21210000, 0x00111111, 0x00000000, 0x00000000, 0x00000000,
+  0x01010000, 0x02020201, 0x00000002, 0x11212100, 0x00001111, 0x00000000,
+  0x00000000, 0x00001101, 0x22222101, 0x22222222, 0x00011121, 0x11111111,
+  0x11010011, 0x00000000, 0x01000000, 0x22010001, 0x22222222, 0x11222222,
+  0x01011111, 0x01111111, 0x00010100, 0x00000000, 0x00000000, 0x22221100,
+  0x22222222, 0x11111122, 0x00002111, 0x00000000, 0x00000000, 0x11210200,
+  0x01000001, 0x22222222, 0x21212122, 0x21111122, 0x00000111, 0x01112102,
+  0x00000000, 0x01112101, 0x22010000, 0x22222222, 0x21111111, 0x11111111,
+  0x01000001, 0x00011111, 0x01000000, 0x00011111, 0x22220100, 0x11222222,
+  0x11112111, 0x00111111, 0x11010000, 0x00000111, 0x00000000, 0x00000000,
+  0x22222201, 0x11212222, 0x21211111, 0x00011111, 0x00000000, 0x01210000,
+  0x00000000, 0x01000000, 0x22212222, 0x11212222, 0x11111111, 0x00000002,
+  0x00000000, 0x00010100, 0x00000000, 0x01000000, 0x22212221, 0x11112122,
+  0x00011111, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x01000000,
+  0x21111121, 0x11111111, 0x00000001, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00010101,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x21210000, 0x00111121, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x11212100, 0x00001111, 0x00000000, 0x00000000,
+  0x00000101, 0x21112100, 0x22222222, 0x00000101, 0x11112121, 0x01010011,
+  0x00000000, 0x01000000, 0x21000011, 0x22222222, 0x21312222, 0x11011111,
+  0x11111111, 0x00110100, 0x00000000, 0x00000000, 0x22222100, 0x22222221,
+  0x11112122, 0x01000111, 0x00000101, 0x00000000, 0x01010000, 0x00000000,
+  0x22222211, 0x22222222, 0x21111122, 0x00000121, 0x00010100, 0x00000000,
+  0x01112101, 0x22010000, 0x22322122, 0x21111121, 0x11212111, 0x01000001,
+  0x00011121, 0x01000000, 0x00011121, 0x22220100, 0x11222222, 0x11212111,
+  0x01111111, 0x11010000, 0x00000111, 0x01000000, 0x00000001, 0x22222201,
+  0x11112222, 0x11111131, 0x00011111, 0x01010000, 0x01010000, 0x00000000,
+  0x01000000, 0x22212222, 0x11112222, 0x21211111, 0x00000021, 0x00000000,
+  0x00011100, 0x00000000, 0x21000000, 0x21212222, 0x11112122, 0x00111111,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x21000000, 0x22222122,
+  0x11111111, 0x00000111, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x01000000, 0x01010101, 0x00010101, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0xeeeeee0d, 0x000dedee, 0x00000000, 0xeeee0d00, 0xeeeeeeee,
+  0x00edeeee, 0x0d000000, 0xeeeeeeee, 0xeeeeeeee, 0x00edeeee, 0xeedd0000,
+  0xeeeeeeee, 0xeeeeeeee, 0x000deeee, 0xeddddd0c, 0xeeeeeeee, 0xeeeeeeee,
+  0x0d00edee, 0xeeeddddd, 0xeeeeeeee, 0xeeeeeeee, 0xdd0d00ee, 0xeedddddd,
+  0xeeeeeeee, 0xeeeeeeee, 0xdddd0d00, 0xeddddddd, 0xeeeeeeee, 0x00eeeeee,
+  0xdddddd0c, 0xdddddddd, 0xeeeeeeed, 0x0000eeee, 0xdddddddd, 0xdddddddd,
+  0xeeeeeeed, 0x0c00000d, 0xdddddddd, 0xdddddddd, 0x00eceddd, 0xdc000000,
+  0xdddcdddd, 0xdddddddd, 0x00000cdd, 0x0c000000, 0xdddddddd, 0x0cdddddd,
+  0x00000000, 0x00000000, 0x0d0d0d0c, 0x0000000c, 0x00000000, 0x00000000,
+  0x0e0e0d00, 0x00000d0e, 0x00000000, 0xee0d0000, 0xeeeeeeee, 0x000dedee,
+  0x00000000, 0xeeeeeeed, 0xeeeeeeee, 0x000eeeee, 0xee0d0000, 0xeeeeeeee,
+  0xeeeeeeee, 0x0000eeee, 0xeddddd00, 0xeeeeeeee, 0xeeeeeeee, 0x0c000dee,
+  0xeeeddddd, 0xeeeeeeee, 0xeeeeeeee, 0xdd0d00ee, 0xeedddddd, 0xeeeeeeee,
+  0xeeeeeeee, 0xdddd0d00, 0xeedddddd, 0xeeeeeeee, 0x00eeeeee, 0xdddddd0d,
+  0xeddddddd, 0xeeeeeeee, 0x0c00eeee, 0xdddddddd, 0xdddddddd, 0xeeeeeeed,
+  0xdd0000ed, 0xdddddddd, 0xdddddddd, 0x0deeeddd, 0xdd0c0000, 0xdddcdddd,
+  0xdddddcdd, 0x0000dcdd, 0xdd0c0000, 0xdddddddd, 0xdcdddddd, 0x00000000,
+  0x0c000000, 0xdddddddd, 0x00000cdd, 0x00000000, 0x00000000, 0x00000000,
+  0xc4000000, 0x00000cc4, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x0c0c0000, 0xc4c50cc5, 0xcc0cc40c, 0x000200c3, 0x00000001, 0x00000000,
+  0x00000000, 0x0c000000, 0xc5c50cca, 0xc40ccc0c, 0x33333333, 0x02032222,
+  0x00000100, 0x00000000, 0x00000000, 0x55cccc0c, 0x44c4c4c5, 0x43444343,
+  0x32333342, 0xc1222222, 0x00000001, 0x00000000, 0xcccbcb00, 0x55646555,
+  0x44445464, 0x22424344, 0x22223103, 0x08111121, 0x00000008, 0xaa0c0000,
+  0xbbbbaacc, 0x655555b5, 0x0004cc65, 0x02020303, 0x8111c20c, 0x00088888,
+  0x00000000, 0xbbbbcc0c, 0xb5bbbbbb, 0x0cccc555, 0x000004c4, 0x01000000,
+  0x08080800, 0x00080808, 0xcb000000, 0xbbbbbbbb, 0x0555bbbb, 0x000c0566,
+  0x00000000, 0x00000000, 0x00000800, 0x00080800, 0xbbbbcc00, 0xbbaababb,
+  0x000c0555, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xcc000000,
+  0xbabbbbcc, 0x00ccaabb, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00080000, 0xcccc0000, 0xcccacbcb, 0x0000000c, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x0c0c0c00, 0x0000000c, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x0c000000, 0x0000000c, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x0c0c000c, 0xc3c4c40c, 0x00020003, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0xccc5ccca, 0x0c0cc4cc, 0x03c3c304, 0x00010302,
+  0x00000100, 0x00000000, 0x00000000, 0x05cbcb00, 0xc40c0c65, 0x334344c3,
+  0x32323233, 0x0c022232, 0x00000000, 0x00000000, 0xcccc0c00, 0x54cc55c5,
+  0x44444454, 0x32424344, 0x22223333, 0x00c11121, 0x00000008, 0xaa0c0000,
+  0xb555ccca, 0x55555555, 0x0444c464, 0x01020404, 0x112122c2, 0x00088111,
+  0x00000000, 0xbbcaca0c, 0x55bbbbbb, 0x0cc56555, 0x03030404, 0x0c000200,
+  0x88880808, 0x00000808, 0xca000000, 0xbbbbbbbb, 0x0c65bbbb, 0x00c6ccc5,
+  0x00000000, 0x08000100, 0x00000800, 0x00000008, 0xbbbbca00, 0xbbbbbbbb,
+  0x00cc6555, 0x00000000, 0x00000000, 0x00000000, 0x08000000, 0xcc000008,
+  0xaabbbbaa, 0x00c5bbaa, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00080000, 0xaacc0c00, 0xccbbbbbb, 0x0000000c, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0xcccccc0c, 0x00000ccc, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x76770700, 0x76666666, 0x00000006, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x87080000, 0x77777777, 0x55656676,
+  0x00000766, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x77778888, 0x77777777, 0x65767677, 0x00006555, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x88080000, 0x77777787, 0x77777777, 0x76667777,
+  0x00000655, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x87888808,
+  0x77777777, 0x77777777, 0x65667777, 0x00000555, 0x00000000, 0x00000000,
+  0x00000000, 0x88000000, 0x87878888, 0x77777777, 0x77777777, 0x65767677,
+  0x00000065, 0x00000000, 0x00000000, 0x08080800, 0x88880808, 0x77777787,
+  0x77777777, 0x77777777, 0x65766676, 0x08080805, 0x00000008, 0x08080000,
+  0x08080808, 0x88888808, 0x77777777, 0x77777777, 0x76777777, 0x05666676,
+  0x08080808, 0x00000808, 0x08080808, 0x08080808, 0x87878888, 0x77777777,
+  0x77777777, 0x76777777, 0x08657677, 0x08080808, 0x08080808, 0x08080808,
+  0x88080008, 0x77778788, 0x77777777, 0x77777777, 0x77767777, 0x08005576,
+  0x08080808, 0x08080808, 0x08080808, 0x88888808, 0x77778788, 0x77777777,
+  0x77777777, 0x77777777, 0x08080885, 0x08080808, 0x08080008, 0x08080808,
+  0x88888888, 0x87878787, 0x87878787, 0x87878787, 0x85878787, 0x08080808,
+  0x00080808, 0x08080000, 0x08080808, 0x88878788, 0x87878787, 0x87878787,
+  0x87878787, 0x08087787, 0x08080808, 0x00000008, 0x08080000, 0x88080808,
+  0x87888888, 0x87878787, 0x87878787, 0x87878787, 0x08080885, 0x00000808,
+  0x00000000, 0x00000000, 0x88080808, 0x87888888, 0x87878787, 0x87878787,
+  0x08777777, 0x00000808, 0x00000000, 0x00000000, 0x00000000, 0x88080000,
+  0x77878888, 0x77777787, 0x77777777, 0x00000676, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x88880000, 0x87878888, 0x77777787, 0x76767777,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x88080000,
+  0x88888888, 0x77778888, 0x00000777, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x08000000, 0x88888888, 0x00088888, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00080800, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x07070000, 0x06060606, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x07000000, 0x76767777,
+  0x65656666, 0x00000006, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x77778708, 0x77777777, 0x55667666, 0x00000675, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x88080000, 0x77778788, 0x77777777,
+  0x65667677, 0x00000655, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x87888800, 0x77777777, 0x77777777, 0x65667777, 0x00000075, 0x00000000,
+  0x00000000, 0x00000000, 0x08000000, 0x77878888, 0x77777777, 0x77777777,
+  0x55667677, 0x00000005, 0x00000000, 0x00000000, 0x08000000, 0x88880808,
+  0x77778788, 0x77777777, 0x77777777, 0x65666676, 0x00080800, 0x00000000,
+  0x08000000, 0x08080808, 0x88888808, 0x77777777, 0x77777777, 0x76777777,
+  0x05666676, 0x08080808, 0x00000808, 0x08080800, 0x08080808, 0x77878888,
+  0x77777777, 0x77777777, 0x76777777, 0x08056677, 0x08080808, 0x08080808,
+  0x08080808, 0x88080008, 0x77878788, 0x77777777, 0x77777777, 0x77767777,
+  0x08005576, 0x08080808, 0x08080808, 0x08080808, 0x88888808, 0x77777787,
+  0x77777777, 0x77777777, 0x76777777, 0x08080855, 0x08080808, 0x08080808,
+  0x08080808, 0x88888888, 0x87878787, 0x87878787, 0x87878787, 0x85878787,
+  0x08080808, 0x00080808, 0x08080800, 0x08080808, 0x87878888, 0x87878787,
+  0x87878787, 0x87878787, 0x08857787, 0x08080808, 0x00000008, 0x08080000,
+  0x88080808, 0x87888788, 0x87878787, 0x87878787, 0x87878787, 0x08080877,
+  0x00000808, 0x00000000, 0x08080000, 0x88880808, 0x87878888, 0x87878787,
+  0x87878787, 0x85878787, 0x00000808, 0x00000000, 0x00000000, 0x00000000,
+  0x88880000, 0x77878888, 0x77777787, 0x77777777, 0x00007676, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x88880800, 0x87878888, 0x77777777,
+  0x76767777, 0x00000007, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x88880800, 0x88888788, 0x77778788, 0x00077677, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x88080000, 0x88888888, 0x07878888,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x08000000, 0x08888808, 0x00000008, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x000c0000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x0000000c, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0xec000000, 0x0000000c, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x0e0c0000, 0x000cecee, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000e00, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000c00, 0x000c0000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0xcc0c0000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x0c000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x0000000c, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x0000000e, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x0c000000, 0x0cecee0e, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x0cec0000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x0c000000,
+  0x00000000, 0xcc000000, 0x0000000c, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x0000000c, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000c00, 0x00000000, 0x00000000, 0x0000cc0c, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x000c0000, 0x00000000, 0x00000000,
+  0x0c000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x0000000c, 0x00000000,
+  0x00000000, 0x00000000, 0x000c0000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000e00, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x000c0000, 0x00000000,
+  0x00000000, 0x00000000, 0x0eeeec0c, 0x0000000c, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0xec0c0000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x0000000c, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x000c0000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x0e000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000c00, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x0e0c0000, 0x000cecee, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x000cec00, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000c00, 0x000c0000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x0c000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x0c000000, 0x000000cc, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x0000000c, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x000cec00, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0xecee0e0c, 0x0000000c, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x0e000000, 0x00000000, 0x0c000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x0000000c, 0x00000000, 0x00000ccc, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000c00, 0x00000000, 0x00000000, 0x00000c00,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00cc0c00, 0x00000000,
+  0x00000000, 0x0c000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000c00, 0x00000000,
+  0x00000000, 0x00000000, 0x0c000000, 0x00000000, 0x00000000, 0x000c0000,
+  0x00000000, 0x00000000, 0x00000000, 0x00ec0c00, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0xeeec0c00, 0x00000c0e, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x0000000e, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000, 0x00000c00, 0x00000000, 0x00000000, 0x00000000, 0x00000000,
+  0x00000000,
 };
 constexpr Sprite DRAM_ATTR kSprites[] = {
-  {62, 26, 0},
-  {30, 27, 806},
-  {60, 23, 1211},
-  {70, 39, 1901},
-  {90, 46, 3266},
+  {62, 26, 0, 0, 629, {0, 404}, 0},
+  {30, 27, 808, 632, 472, {840, 1052}, 1},
+  {60, 23, 1216, 1104, 505, {1264, 1624}, 2},
+  {70, 39, 1908, 1612, 1064, {1984, 2684}, 3},
+  {90, 46, 3276, 2676, 251, {3384, 4420}, 4},
 };
@@ -0,0 +1,72 @@
+
+#pragma once
+
+#include <esp_attr.h>
+#include <stdint.h>
+
+// Unrolled draw routines for some of the sprites in sprites.h, generated by
+// sprites2c.py --compiled. Each one draws sprite rows [first_row, last_row)
+// to |d|, the backbuffer byte at the left of row |first_row|, whose address
+// modulo 4 is the routine's alignment.
+
+constexpr int kCompiledSpriteLineBytes = 96;
+
+typedef void (*CompiledSpriteRoutine)(uint8_t* d, int first_row, int last_row);
+
+struct CompiledSprite {
+  // Indexed by alignment, or all null if the sprite isn't compiled.
+  CompiledSpriteRoutine routines[4];
+  // Estimated code size of all four routines.
+  uint32_t code_bytes;
+};
+
+enum CompiledSpriteVariant {
+  kCompiledDefault,
+  kCompiledBlend,
+  kCompiledBlend1X,
+};
+
+inline void StoreCompiled8(uint8_t* d, uint8_t value) {
+  *d = value;
+}
+
+inline void StoreCompiled16(uint8_t* d, uint16_t value) {
+  *reinterpret_cast<uint16_t*>(d) = value;
+}
+
+inline void StoreCompiled32(uint8_t* d, uint32_t value) {
+  *reinterpret_cast<uint32_t*>(d) = value;
+}
+
+// Keeps the pixel under |mask| and sets the other one to |value|.
+inline void BlendCompiled8(uint8_t* d, uint8_t mask, uint8_t value) {
+  *d = (*d & mask) | value;
+}
+
+constexpr CompiledSprite kCompiledSprites[][3] = {
+  {
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+  },
+  {
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+  },
+  {
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+  },
+  {
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+  },
+  {
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+    {{nullptr, nullptr, nullptr, nullptr}, 0},
+  },
+};
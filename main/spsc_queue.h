@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <atomic>
+
+// A fixed size single-producer, single-consumer ring buffer. One task may
+// Push() and another Pop() without locks; each index is only written by one
+// side, so the atomics need nothing but loads and stores, which the LX106
+// has without a compare-and-swap.
+template <typename T, size_t N>
+class SPSCQueue {
+ public:
+  static_assert(N && !(N & (N - 1)), "Capacity must be a power of two");
+  static constexpr size_t kCapacity = N;
+
+  // Producer only. Returns false if the queue is full.
+  bool Push(const T& item) {
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == N)
+      return false;
+    items_[tail & (N - 1)] = item;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer only. Returns false if the queue is empty.
+  bool Pop(T& item) {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire))
+      return false;
+    item = items_[head & (N - 1)];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Exact only when called from either side while the other is idle.
+  size_t size() const {
+    return tail_.load(std::memory_order_acquire) -
+           head_.load(std::memory_order_acquire);
+  }
+
+ private:
+  // Free running; the slot is the index modulo N.
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::array<T, N> items_;
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <stdio.h>
 #include <FreeRTOS.h>
 #include <freertos/task.h>
 
@@ -32,4 +33,36 @@ inline constexpr uint32_t ExplodeRGB565(uint16_t rgb) {
 inline constexpr uint16_t UnexplodeRGB565(uint32_t rgb) {
   return (rgb & 0b11111) | ((rgb & 0b11111100000000) >> 3) |
          ((rgb & 0b1111100000000000000000) >> 6);
-}
\ No newline at end of file
+}
+// from 25 bits: 000rrrrr000gggggg000bbbbb
+//   to  8 bits:                  rrrgggbb
+inline constexpr uint8_t UnexplodeRGB332(uint32_t rgb) {
+  return ((rgb >> 14) & 0b11100000) | ((rgb >> 9) & 0b11100) |
+         ((rgb >> 3) & 0b11);
+}
+
+// Expands an RGB332 pixel to RGB565 the way the panel does, by repeating the
+// high bits.
+inline uint16_t ExpandRGB332(uint8_t pixel) {
+  uint16_t r = pixel >> 5;
+  uint16_t g = (pixel >> 2) & 0b111;
+  uint16_t b = pixel & 0b11;
+  return ((r << 2 | r >> 1) << 11) | ((g << 3 | g) << 5) |
+         (b << 3 | b << 1 | b >> 1);
+}
+
+// Interpolates each component of two exploded colors by |amount| / 255, so
+// that 255 gives |to|.
+inline uint32_t LerpExplodedRGB565(uint32_t from,
+                                   uint32_t to,
+                                   uint8_t amount) {
+  constexpr uint32_t kMasks[] = {0b11111, 0b11111100000000,
+                                 0b1111100000000000000000};
+  uint32_t result = 0;
+  for (uint32_t mask : kMasks) {
+    int32_t a = from & mask;
+    int32_t b = to & mask;
+    result |= (a + (b - a) * amount / 255) & mask;
+  }
+  return result;
+}